@@ -2,88 +2,256 @@
 
 
 #include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
 #include "Errors.hpp"
+#include "../Utils/Constexpr.hpp"
 
 namespace Meta {
+    namespace Detail {
+        /**
+         * @brief The storage behind an ErrorUnion: the value and a pointer to the error's site, null when there is
+         *         no error. Trivially copyable Ts get trivially copyable storage, so small ErrorUnions are returned
+         *         in registers.
+         */
+        template<typename T, bool Trivial = std::is_trivially_copyable<T>::value && std::is_trivially_destructible<T>::value>
+        class ErrorUnionStorage;
+
+        template<typename T>
+        class ErrorUnionStorage<T, true> {
+        protected:
+            union {
+                T stored;
+            };
+            const ErrorSite* site;
+
+            META_CONSTEXPR20 ErrorUnionStorage() : stored(), site(nullptr) {}
+            META_CONSTEXPR20 ErrorUnionStorage(const T& v) : stored(v), site(nullptr) {}
+            META_CONSTEXPR20 ErrorUnionStorage(const ErrorSite& site) : site(&site) {}
+        };
+
+        template<typename T>
+        class ErrorUnionStorage<T, false> {
+        protected:
+            union {
+                T stored;
+            };
+            const ErrorSite* site;
+
+            META_CONSTEXPR20 ErrorUnionStorage() : stored(), site(nullptr) {}
+            META_CONSTEXPR20 ErrorUnionStorage(const T& v) : stored(v), site(nullptr) {}
+            META_CONSTEXPR20 ErrorUnionStorage(T&& v) : stored(std::move(v)), site(nullptr) {}
+            META_CONSTEXPR20 ErrorUnionStorage(const ErrorSite& site) : site(&site) {}
+
+            META_CONSTEXPR20 ~ErrorUnionStorage() {
+                reset();
+            }
+
+            META_CONSTEXPR20 ErrorUnionStorage(const ErrorUnionStorage& other) : site(other.site) {
+                if (site == nullptr) {
+                    constructAt(&stored, other.stored);
+                }
+            }
+
+            META_CONSTEXPR20 ErrorUnionStorage(ErrorUnionStorage&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+                : site(other.site) {
+                if (site == nullptr) {
+                    constructAt(&stored, std::move(other.stored));
+                }
+            }
+
+            META_CONSTEXPR20 ErrorUnionStorage& operator=(const ErrorUnionStorage& other) {
+                if (site == nullptr && other.site == nullptr) {
+                    stored = other.stored;
+                } else {
+                    reset();
+                    if (other.site == nullptr) {
+                        constructAt(&stored, other.stored);
+                    }
+                    site = other.site;
+                }
+                return *this;
+            }
+
+            META_CONSTEXPR20 ErrorUnionStorage& operator=(ErrorUnionStorage&& other) noexcept(std::is_nothrow_move_assignable<T>::value) {
+                if (site == nullptr && other.site == nullptr) {
+                    stored = std::move(other.stored);
+                } else {
+                    reset();
+                    if (other.site == nullptr) {
+                        constructAt(&stored, std::move(other.stored));
+                    }
+                    site = other.site;
+                }
+                return *this;
+            }
+
+        private:
+            META_CONSTEXPR20 void reset() {
+                if (site == nullptr) {
+                    stored.~T();
+                }
+            }
+        };
+    }
+
     /**
      * @brief Contains etiher an error or a return value depending on the result
      *         of an operation.
      */
     template<typename T>
-    class ErrorUnion {
+    class ErrorUnion : private Detail::ErrorUnionStorage<T> {
     private:
-        bool isError;
-        union {
-            T value;
-            Meta::Error error;
-        };
+        using Storage = Detail::ErrorUnionStorage<T>;
 
     public:
-        ErrorUnion() : isError(false), value() {}
+        META_CONSTEXPR20 ErrorUnion() : Storage() {}
 
-        ErrorUnion(T value) : isError(false), value(value) {}
-        ErrorUnion(Meta::Error error) : isError(true), error(error) {}
+        META_CONSTEXPR20 ErrorUnion(T value) : Storage(std::move(value)) {}
+        META_CONSTEXPR20 ErrorUnion(const Meta::ErrorSite& site) : Storage(site) {}
 
-        ~ErrorUnion() = default;
+        META_CONSTEXPR20 bool hasError() const { return this->site != nullptr; }
+        META_CONSTEXPR20 explicit operator bool() const { return this->site == nullptr; }
+        META_CONSTEXPR20 T getValue() const { return this->stored; }
 
-        ErrorUnion(const ErrorUnion& other) : isError(other.isError) {
-            if (isError) {
-                error = other.error;
-            } else {
-                value = other.value;
-            }
+        /**
+         * @brief Access the value in place. Only valid if !hasError(); the rvalue overload moves the value out.
+         */
+        META_CONSTEXPR20 T& value() & { return this->stored; }
+        META_CONSTEXPR20 const T& value() const & { return this->stored; }
+        META_CONSTEXPR20 T&& value() && { return std::move(this->stored); }
+
+        META_CONSTEXPR20 T& operator*() & { return this->stored; }
+        META_CONSTEXPR20 const T& operator*() const & { return this->stored; }
+        META_CONSTEXPR20 T&& operator*() && { return std::move(this->stored); }
+
+        META_CONSTEXPR20 T* operator->() { return &this->stored; }
+        META_CONSTEXPR20 const T* operator->() const { return &this->stored; }
+
+        /**
+         * @brief The value, or fallback if this holds an error.
+         */
+        template<typename U>
+        META_CONSTEXPR20 T value_or(U&& fallback) const & {
+            return this->site ? static_cast<T>(std::forward<U>(fallback)) : this->stored;
         }
-        ErrorUnion& operator=(const ErrorUnion& other) {
-            isError = other.isError;
-            if (isError) {
-                error = other.error;
-            } else {
-                value = other.value;
-            }
-            return *this;
+
+        template<typename U>
+        META_CONSTEXPR20 T value_or(U&& fallback) && {
+            return this->site ? static_cast<T>(std::forward<U>(fallback)) : std::move(this->stored);
         }
 
-        ErrorUnion(ErrorUnion&& other) noexcept : isError(other.isError) {
-            if (isError) {
-                error = other.error;
-            } else {
-                value = std::move(other.value);
+        /**
+         * @brief Chain a fallible operation: f receives the value and returns an ErrorUnion, errors pass through.
+         */
+        template<typename F>
+        META_CONSTEXPR20 auto and_then(F&& f) & { return chain(*this, std::forward<F>(f)); }
+        template<typename F>
+        META_CONSTEXPR20 auto and_then(F&& f) const & { return chain(*this, std::forward<F>(f)); }
+        template<typename F>
+        META_CONSTEXPR20 auto and_then(F&& f) && { return chain(std::move(*this), std::forward<F>(f)); }
+
+        /**
+         * @brief Map the value through f, wrapping its result in an ErrorUnion; errors pass through.
+         */
+        template<typename F>
+        META_CONSTEXPR20 auto transform(F&& f) & { return map(*this, std::forward<F>(f)); }
+        template<typename F>
+        META_CONSTEXPR20 auto transform(F&& f) const & { return map(*this, std::forward<F>(f)); }
+        template<typename F>
+        META_CONSTEXPR20 auto transform(F&& f) && { return map(std::move(*this), std::forward<F>(f)); }
+        META_CONSTEXPR20 Meta::Error getError() const {
+            return this->site ? Meta::Error{*this->site->errorDef, this->site->msg, this->site->line} : Meta::Error();
+        }
+
+        /**
+         * @brief The site the error was raised at. Only valid if hasError().
+         */
+        META_CONSTEXPR20 const Meta::ErrorSite& getErrorSite() const { return *this->site; }
+
+    private:
+        template<typename Self, typename F>
+        static META_CONSTEXPR20 auto chain(Self&& self, F&& f) {
+            using Result = std::decay_t<decltype(f(std::forward<Self>(self).value()))>;
+            if (self.site) {
+                return Result(*self.site);
             }
+            return f(std::forward<Self>(self).value());
         }
 
-        ErrorUnion& operator=(ErrorUnion&& other) noexcept {
-            isError = other.isError;
-            if (isError) {
-                error = other.error;
+        template<typename Self, typename F>
+        static META_CONSTEXPR20 auto map(Self&& self, F&& f) {
+            using U = std::decay_t<decltype(f(std::forward<Self>(self).value()))>;
+            if (self.site) {
+                return ErrorUnion<U>(*self.site);
+            }
+            if constexpr (std::is_void<U>::value) {
+                f(std::forward<Self>(self).value());
+                return ErrorUnion<void>();
             } else {
-                value = std::move(other.value);
+                return ErrorUnion<U>(f(std::forward<Self>(self).value()));
             }
-            return *this;
         }
-
-        bool hasError() const { return isError; }
-        T getValue() const { return value; }
-        Meta::Error getError() const { return error; }
     };
 
     // Special case for void
     template <>
     class ErrorUnion<void> {
     private:
-        bool isError;
-        Meta::Error error;
+        const Meta::ErrorSite* site;
 
     public:
-        ErrorUnion() : isError(false), error(Meta::Error()) {}
+        META_CONSTEXPR20 ErrorUnion() : site(nullptr) {}
 
-        ErrorUnion(Meta::Error error) :  isError(true), error(error) {}
+        META_CONSTEXPR20 ErrorUnion(const Meta::ErrorSite& site) : site(&site) {}
 
-        bool hasError() {
-            return isError;
+        META_CONSTEXPR20 bool hasError() const {
+            return site != nullptr;
         }
 
-        Meta::Error getError() {
-            return error;
+        META_CONSTEXPR20 Meta::Error getError() const {
+            return site ? Meta::Error{*site->errorDef, site->msg, site->line} : Meta::Error();
+        }
+
+        /**
+         * @brief The site the error was raised at. Only valid if hasError().
+         */
+        META_CONSTEXPR20 const Meta::ErrorSite& getErrorSite() const {
+            return *site;
+        }
+
+        META_CONSTEXPR20 explicit operator bool() const {
+            return site == nullptr;
+        }
+
+        /**
+         * @brief Chain a fallible operation: f takes no arguments and returns an ErrorUnion, errors pass through.
+         */
+        template<typename F>
+        META_CONSTEXPR20 auto and_then(F&& f) const {
+            using Result = std::decay_t<decltype(f())>;
+            if (site) {
+                return Result(*site);
+            }
+            return f();
+        }
+
+        /**
+         * @brief Produce a value with f, wrapping its result in an ErrorUnion; errors pass through.
+         */
+        template<typename F>
+        META_CONSTEXPR20 auto transform(F&& f) const {
+            using U = std::decay_t<decltype(f())>;
+            if (site) {
+                return ErrorUnion<U>(*site);
+            }
+            if constexpr (std::is_void<U>::value) {
+                f();
+                return ErrorUnion<void>();
+            } else {
+                return ErrorUnion<U>(f());
+            }
         }
     };
-}
\ No newline at end of file
+}
@@ -5,6 +5,13 @@
 #include <array>
 #include <cstring>
 
+/**
+ * @brief How many error codes the global registry can index.
+ */
+#ifndef META_ERROR_REGISTRY_SIZE
+#define META_ERROR_REGISTRY_SIZE 128
+#endif
+
 namespace Meta {
     typedef struct {
         size_t errorCode;
@@ -13,36 +20,95 @@ namespace Meta {
     } ErrorDef;
 
     /**
-     * @brief A simple error registery that allows automatically defining errors
-     *         at compile-time.
+     * @brief Global error registry: a contiguous table indexed directly by error code, so turning a code back into
+     *         its definition is a single bounds check and load.
+     *
+     * Codes are handed out in registration order, so they are unique across the whole program but may change between
+     *  builds; decode off-board with the serialized table of the same build. Each REGISTER_ERROR site owns the
+     *  definition it registers and only registers it once, so errors defined in headers must be inline variables to
+     *  get the same code in every translation unit. The table holds one pointer per code; definitions registered past
+     *  META_ERROR_REGISTRY_SIZE still get a unique code but cannot be looked up, and are counted by unindexed().
      */
-    template<size_t N>
-    class Errors {
+    class ErrorRegistry {
     private:
-        static std::array<ErrorDef, N> errors;
+        static inline const ErrorDef* table[META_ERROR_REGISTRY_SIZE] = {};
+        static inline size_t count = 0;
 
     public:
-        static constexpr const ErrorDef& registerError(const char* errorName, const char* file) {
-            ErrorDef error = {N, errorName, file};
-            errors[N] = error;
-            return errors[N];
+        /**
+         * @brief Give def the next code and index it. def must have static storage duration and not be registered
+         *         yet; REGISTER_ERROR takes care of both.
+         */
+        static const ErrorDef& add(ErrorDef& def) {
+            def.errorCode = count++;
+            if (def.errorCode < META_ERROR_REGISTRY_SIZE) {
+                table[def.errorCode] = &def;
+            }
+            return def;
+        }
+
+        /**
+         * @return The definition registered under code, or null if there is none.
+         */
+        static const ErrorDef* lookup(size_t code) {
+            return code < META_ERROR_REGISTRY_SIZE ? table[code] : nullptr;
+        }
+
+        /**
+         * @brief How many errors are registered.
+         */
+        static size_t size() {
+            return count < META_ERROR_REGISTRY_SIZE ? count : META_ERROR_REGISTRY_SIZE;
         }
-    };
 
-    template<size_t N>
-    std::array<ErrorDef, N> Errors<N>::errors;
+        /**
+         * @brief How many errors were registered past the end of the table, 0 unless META_ERROR_REGISTRY_SIZE is too
+         *         small for the program.
+         */
+        static size_t unindexed() {
+            return count - size();
+        }
+
+        /**
+         * @brief Serialize the registry for off-board decoding, as one [code:u16][name length:u8][name][file
+         *         length:u8][file] entry per error. Entries that do not fit are left out.
+         *
+         * @return How many bytes were written into out.
+         */
+        static size_t serialize(uint8_t* out, size_t capacity) {
+            size_t used = 0;
+            for (size_t code = 0; code < size(); code++) {
+                const ErrorDef* def = table[code];
+                const size_t nameLen = strnlen(def->errorName, 0xFF);
+                const size_t fileLen = strnlen(def->file, 0xFF);
+                const size_t entryLen = 2 + 1 + nameLen + 1 + fileLen;
+                if (used + entryLen > capacity) {
+                    break;
+                }
+                out[used++] = (uint8_t)(code & 0xFF);
+                out[used++] = (uint8_t)(code >> 8);
+                out[used++] = (uint8_t)nameLen;
+                memcpy(out + used, def->errorName, nameLen);
+                used += nameLen;
+                out[used++] = (uint8_t)fileLen;
+                memcpy(out + used, def->file, fileLen);
+                used += fileLen;
+            }
+            return used;
+        }
+    };
 
     #define SIMPLIFY_FILE_NAME(file) strrchr(file, '/') ? strrchr(file, '/') + 1 : file
 
     /**
-     * @brief Define an error with a unique code.
+     * @brief Define an error with a unique code. The definition is registered once, the first time the site runs; in
+     *         a header, assign it to an inline variable so every translation unit shares that one site.
      */
-    #define REGISTER_ERROR(errorName) Errors<__COUNTER__>::registerError(errorName, SIMPLIFY_FILE_NAME(__FILE__))
-
-    /**
-    * @brief Global error registry
-    */
-    static constexpr auto errors = Errors<__COUNTER__>();
+    #define REGISTER_ERROR(errorName) ([]() -> const Meta::ErrorDef& { \
+            static Meta::ErrorDef def = {0, errorName, SIMPLIFY_FILE_NAME(__FILE__)}; \
+            static const Meta::ErrorDef& registered = Meta::ErrorRegistry::add(def); \
+            return registered; \
+        }())
 
     // Error Definition
     typedef struct {
@@ -51,6 +117,16 @@ namespace Meta {
         size_t line;
     } Error;
 
+    /**
+     * @brief Where an error was raised. One static instance exists per MAKE_ERROR call site, so an error can travel
+     *         as a single pointer to its site while the context stays in this side table.
+     */
+    typedef struct {
+        const ErrorDef* errorDef;
+        const char* msg;
+        size_t line;
+    } ErrorSite;
+
     inline bool operator==(const Error& lhs, const ErrorDef& rhs) {
         return lhs.errorDef.errorCode == rhs.errorCode;
     }
@@ -59,9 +135,20 @@ namespace Meta {
         return rhs == lhs;
     }
 
+    inline bool operator==(const ErrorSite& lhs, const ErrorDef& rhs) {
+        return lhs.errorDef->errorCode == rhs.errorCode;
+    }
+
+    inline bool operator==(const ErrorDef& lhs, const ErrorSite& rhs) {
+        return rhs == lhs;
+    }
+
     /**
-     * @brief Create an occurance of a given error def.
+     * @brief Create an occurance of a given error def. errorDef must have static storage duration (registered errors
+     *         do) and msg should be a string literal; both are captured once per call site.
      */
-    #define MAKE_ERROR(errorDef, msg) Error{errorDef, msg, __LINE__}
+    #define MAKE_ERROR(errorDef, msg) ([]() -> const Meta::ErrorSite& { \
+            static const Meta::ErrorSite site = {&(errorDef), msg, __LINE__}; \
+            return site; \
+        }())
 }
-  
\ No newline at end of file
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "ILogger.hpp"
+#include "Trace.hpp"
+#include "../Structures/MpscQueue.hpp"
+#include "../Structures/RingBuffer.hpp"
+
+namespace Meta {
+    /**
+     * @brief A logger that only captures log calls into a lock-free record queue. Formatting and I/O happen in
+     *         drain(), which is meant to be called from a low priority task or idle hook.
+     *
+     * With the default RingBuffer queue logging is single producer: every LOG_* call must come from the same context
+     *  (drain may run elsewhere). With MpscQueue any number of threads or cores may log at once; records are written
+     *  whole, one at a time, in the order they were queued. Either way a full queue drops the record and counts it
+     *  rather than blocking the caller. Format arguments are captured by value, so string arguments must outlive the
+     *  record. Timestamps are taken by the sink when the record is drained. Calls whose arguments do not fit a record
+     *  (META_LOG_RECORD_ARGS_SIZE) cannot be queued: they are formatted and written into the sink by the caller.
+     *
+     * @tparam Depth How many records can be pending at once. Must be a power of two.
+     * @tparam Queue The record queue, RingBuffer (single producer) or MpscQueue (multi producer).
+     */
+    template<size_t Depth = 32, template<typename, size_t> class Queue = RingBuffer>
+    class AsyncLogger : public ILogger {
+    private:
+        ILogger& sink; // Where drained records are written
+        Queue<LogRecord, Depth> records;
+        std::atomic<size_t> dropped; // How many records were lost to a full queue since the last drain
+
+        void submit(const LogRecord& record) override {
+            if (records.push(record).hasError()) {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        void submitFormatted(LogLevel level, const char* file, size_t line, const char* text) override {
+            sink.log(level, "%s", file, line, text);
+        }
+
+    public:
+        AsyncLogger(ILogger& sink, LogLevel level = LOG_LEVEL_DEBUG) : ILogger(level, true), sink(sink), dropped(0) {}
+
+        /**
+         * @brief Raw writes bypass the queue and go straight to the sink.
+         */
+        void rawLog(const char* msg) override {
+            sink.rawLog(msg);
+        }
+
+        void rawWrite(const char* data, size_t len) override {
+            sink.rawWrite(data, len);
+        }
+
+        /**
+         * @brief Format and write up to max pending records into the sink.
+         *
+         * @return How many records were written.
+         */
+        size_t drain(size_t max = Depth) {
+            META_TRACE_SCOPE("AsyncLogger::drain");
+            size_t written = 0;
+            while (written < max) {
+                auto record = records.pop();
+                if (record.hasError()) {
+                    break;
+                }
+                const LogRecord& r = record.getValue();
+                r.emit(sink, r);
+                written++;
+            }
+
+            const size_t lost = dropped.exchange(0, std::memory_order_relaxed);
+            if (lost) {
+                sink.log(LOG_LEVEL_WARNING, "Dropped %zu log records", __FILE__, __LINE__, lost);
+            }
+            return written;
+        }
+
+        /**
+         * @brief How many records are waiting to be drained.
+         */
+        size_t pending() const {
+            return records.size();
+        }
+
+        /**
+         * @brief How many records were dropped to a full queue since the last drain.
+         */
+        size_t droppedSinceDrain() const {
+            return dropped.load(std::memory_order_relaxed);
+        }
+    };
+
+    /**
+     * @brief An AsyncLogger any number of threads or cores may log into at once.
+     */
+    template<size_t Depth = 32>
+    using MpscAsyncLogger = AsyncLogger<Depth, MpscQueue>;
+}
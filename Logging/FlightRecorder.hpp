@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "ILogger.hpp"
+#include "Timestamp.hpp"
+#include "../Structures/Buffer.hpp"
+#include "../Structures/RingBuffer.hpp"
+
+namespace Meta {
+    /**
+     * @brief A sink that keeps the most recent log output in RAM, for dumping after a fault (a crash buffer). Once
+     *         full, the oldest lines are dropped whole to make room, so the recorder always starts at a line.
+     *
+     * Nothing is written anywhere until drain(). Logging evicts from the same ring drain() reads, so both must run in
+     *  the same context, or drain() only once logging has stopped (e.g. from a fault handler). Nothing logs.
+     *
+     * @tparam C How many characters are kept. Must be a power of two.
+     */
+    template<size_t C>
+    class FlightRecorder : public ILogger {
+    private:
+        RingBuffer<char, C> ring;
+        ITimestamp* timestamp; // Where line timestamps come from
+
+        /**
+         * @brief Make room for len more characters, by dropping the oldest ones and then the rest of the line the cut
+         *         landed in.
+         */
+        void evict(size_t len) {
+            const size_t free = C - ring.size();
+            if (len <= free) {
+                return;
+            }
+            ring.skip(len - free);
+            while (!ring.empty()) {
+                if (ring.pop().getValue() == '\r') {
+                    break;
+                }
+            }
+        }
+
+    public:
+        FlightRecorder(LogLevel level = LOG_LEVEL_DEBUG, ITimestamp& timestamp = Timestamps::monotonic)
+            : ILogger(level), ring(), timestamp(&timestamp) {}
+
+        size_t writeTimestamp(char* out, size_t capacity) override {
+            return timestamp->write(out, capacity);
+        }
+
+        void rawLog(const char* msg) override {
+            rawWrite(msg, strlen(msg));
+        }
+
+        void rawWrite(const char* data, size_t len) override {
+            if (len > C) {
+                data += len - C;
+                len = C;
+            }
+            evict(len);
+            ring.append(data, len);
+        }
+
+        /**
+         * @brief Write everything recorded into out, oldest first, and forget it.
+         *
+         * @return How many characters were written.
+         */
+        size_t drain(ILogger& out) {
+            Buffer<char, 64> chunk;
+            size_t written = 0;
+            while (ring.take(chunk)) {
+                out.rawWrite(chunk.cArr(), chunk.size());
+                written += chunk.size();
+            }
+            return written;
+        }
+
+        /**
+         * @brief Forget everything recorded.
+         */
+        void clear() {
+            ring.clear();
+        }
+
+        /**
+         * @brief How many characters are recorded.
+         */
+        size_t size() const {
+            return ring.size();
+        }
+
+        static constexpr size_t capacity() {
+            return C;
+        }
+    };
+}
@@ -2,10 +2,52 @@
 
 #include <cstddef>
 #include <cstdint>
-#include <cstdio>
 #include <array>
+#include <atomic>
 #include <iostream>
-#include <ctime>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include "Timestamp.hpp"
+#include "../Structures/StaticString.hpp"
+#include "../Utils/Format.hpp"
+#include "../Utils/Hex.hpp"
+#include "../Utils/Locks.hpp"
+
+/**
+ * @brief How many bytes of arguments a deferred log record can carry. Deferred loggers format calls with more in
+ *         place instead.
+ */
+#ifndef META_LOG_RECORD_ARGS_SIZE
+#define META_LOG_RECORD_ARGS_SIZE 32
+#endif
+
+/**
+ * @brief How many characters a formatted log line (header and message) can hold. Longer lines are truncated.
+ */
+#ifndef META_LOG_LINE_SIZE
+#define META_LOG_LINE_SIZE 256
+#endif
+
+/**
+ * @brief The least severe level that is compiled in at all. LOG_* calls below it expand to nothing, so their
+ *         arguments are never evaluated. The runtime level still filters everything at or above it.
+ */
+#ifndef META_LOG_MIN_LEVEL
+#define META_LOG_MIN_LEVEL Meta::LOG_LEVEL_DEBUG
+#endif
+
+/**
+ * @brief Whether a log level survives the compile-time filter.
+ */
+#define META_LOG_ENABLED(level) ((level) <= META_LOG_MIN_LEVEL)
+
+/*
+ * META_LOGGER_TYPE binds the LOG macros to a single BasicLogger type at compile time instead of LogBroker's runtime
+ *  ILogger, e.g. -DMETA_LOGGER_TYPE=UartLogger. Every call then goes straight to that type's rawWrite() and can be
+ *  inlined. The type has to be complete wherever the library logs, so META_LOGGER_HEADER names the header it is
+ *  declared in, e.g. -DMETA_LOGGER_HEADER='"UartLogger.hpp"', and is included at the end of this one.
+ */
 
 namespace Meta {
     typedef enum {
@@ -15,173 +57,489 @@ namespace Meta {
         LOG_LEVEL_DEBUG = 3,
     } LogLevel;
 
+    class ILogger;
+
     /**
-     * @brief An abstract logger wrapper for interfacing with a given system's
-     *         logging system.
+     * @brief A log call captured for later formatting. The format string and file name are only referenced, so they
+     *         must outlive the record (string literals do).
      */
-    class ILogger {
+    typedef struct LogRecord {
+        void (*emit)(ILogger& sink, const struct LogRecord& record); // Unpacks args and logs them into sink
+        const char* msg;
+        const char* file;
+        size_t line;
+        LogLevel level;
+        uint8_t args[META_LOG_RECORD_ARGS_SIZE]; // Packed argument bytes
+    } LogRecord;
+
+    /**
+     * @brief Packs a set of (trivially copyable) log arguments into a LogRecord and back out again. Only instantiated
+     *         for argument sets that FIT.
+     */
+    template<typename... Args>
+    class LogArgs {
     private:
-        virtual const char* getTimestamp() = 0;
+        static constexpr size_t offsetOf(size_t idx) {
+            constexpr size_t sizes[] = {sizeof(Args)..., 0};
+            size_t offset = 0;
+            for (size_t i = 0; i < idx; i++) {
+                offset += sizes[i];
+            }
+            return offset;
+        }
 
-        LogLevel level;
+        template<typename Arg>
+        static Arg read(const uint8_t* in, size_t offset) {
+            Arg arg;
+            memcpy(&arg, in + offset, sizeof(Arg));
+            return arg;
+        }
+
+        template<size_t... I>
+        static void emit(ILogger& sink, const LogRecord& record, std::index_sequence<I...>);
 
     public:
-        ILogger(LogLevel level) : level(level) {}
+        /**
+         * @brief Whether the arguments can be carried by a record at all.
+         */
+        static constexpr bool FITS = offsetOf(sizeof...(Args)) <= META_LOG_RECORD_ARGS_SIZE &&
+                                     (std::is_trivially_copyable<Args>::value && ...);
 
-        virtual void rawLog(const char* msg) = 0;
+        static void pack(uint8_t* out, const Args&... args) {
+            size_t offset = 0;
+            ((memcpy(out + offset, &args, sizeof(Args)), offset += sizeof(Args)), ...);
+            (void)offset;
+        }
 
-        LogLevel getLevel() const {
-            return level;
+        static void emit(ILogger& sink, const LogRecord& record) {
+            emit(sink, record, std::index_sequence_for<Args...>{});
         }
+    };
 
-        void writeLevel(LogLevel level) {
+    namespace Detail {
+        inline const char* levelTag(LogLevel level) {
             switch (level) {
                 case LOG_LEVEL_DEBUG:
-                    rawLog("[DEBUG]:");
-                    break;
+                    return "[DEBUG]:";
                 case LOG_LEVEL_INFO:
-                    rawLog("[INFO]:");
-                    break;
+                    return "[INFO]:";
                 case LOG_LEVEL_WARNING:
-                    rawLog("[WARNING]:");
-                    break;
+                    return "[WARNING]:";
                 case LOG_LEVEL_ERROR:
-                    rawLog("[ERROR]:");
-                    break;
+                    return "[ERROR]:";
             }
+            return "";
         }
 
-        void log(LogLevel level, const char* msg, const char* file, size_t line) {
-            if (level > this->level) 
-                return;
-            
-            // Log level string
-            writeLevel(level);
+        static constexpr size_t LOG_TERMINATOR_SIZE = 2; // "\n\r"
+
+        /**
+         * @brief A log line being assembled, with room for the terminator past META_LOG_LINE_SIZE.
+         */
+        typedef StaticString<META_LOG_LINE_SIZE + LOG_TERMINATOR_SIZE> LogLineString;
 
-            // Log timestamp
-            this->rawLog(getTimestamp());
+        /**
+         * @brief The formatted message of a log call, without its header.
+         */
+        typedef StaticString<META_LOG_LINE_SIZE> LogMessageString;
 
-            this->rawLog(":");
+        /**
+         * @brief Assemble a whole log line (header, formatted message, terminator) and hand it to sink in a single
+         *         rawWrite. Shared by ILogger and BasicLogger: sink needs writeTimestamp(out, capacity) and
+         *         rawWrite(data, len), which are direct calls when its type is concrete.
+         */
+        template<typename Sink, typename... Args>
+        inline void writeLogLine(Sink& sink, LogLevel level, const char* msg, const char* file, size_t line,
+                                 const Args&... args) {
+            LogLineString out;
+            out.append(levelTag(level));
+            out.advance(sink.writeTimestamp(out.tail(), out.remaining()));
+            out.append(':');
+            out.append(file);
+            out.append(':');
+            char digits[Format::MAX_INTEGER_SIZE];
+            out.append(digits, Format::writeDecimal(line, digits));
+            out.append(": ", 2);
+            out.format(msg, args...);
+
+            out.truncate(META_LOG_LINE_SIZE);
+            out.append("\n\r", LOG_TERMINATOR_SIZE);
+            sink.rawWrite(out.cStr(), out.size());
+        }
 
-            this->rawLog(file);
-            this->rawLog(":");
-            
-            char lineStr[10];
-            snprintf(lineStr, sizeof(lineStr), "%zu", line);
-            this->rawLog(lineStr);
-            
-            this->rawLog(": ");
+        /**
+         * @brief Write bytes into sink as hex, 16 per line. Lines are encoded straight from data and handed to
+         *         rawWrite a few at a time.
+         */
+        template<typename Sink>
+        inline void writeHexLines(Sink& sink, const void* data, size_t len) {
+            constexpr size_t LINES_PER_WRITE = 4;
+            const uint8_t* bytes = static_cast<const uint8_t*>(data);
+            char out[LINES_PER_WRITE * Hex::LINE_SIZE];
+            while (len) {
+                size_t used = 0;
+                for (size_t line = 0; line < LINES_PER_WRITE && len; line++) {
+                    const size_t n = len < Hex::BYTES_PER_LINE ? len : Hex::BYTES_PER_LINE;
+                    used += Hex::dumpLine(bytes, n, out + used);
+                    bytes += n;
+                    len -= n;
+                }
+                sink.rawWrite(out, used);
+            }
+        }
+    }
 
-            // Log message
-            this->rawLog(msg);
-            
-            this->rawLog("\n\r");
+    /**
+     * @brief An abstract logger wrapper for interfacing with a given system's
+     *         logging system.
+     */
+    class ILogger {
+    private:
+        /**
+         * @brief The timestamp written into each line header, unless writeTimestamp is overridden.
+         */
+        virtual const char* getTimestamp() {
+            return "";
         }
 
-        // printf style log
+        LogLevel level;
+        bool deferred; // Whether log calls are captured as records instead of being written immediately
+
+        template<typename... Args>
+        void defer(LogLevel level, const char* msg, const char* file, size_t line, const Args&... args) {
+            if constexpr (LogArgs<Args...>::FITS) {
+                LogRecord record;
+                record.emit = &LogArgs<Args...>::emit;
+                record.msg = msg;
+                record.file = file;
+                record.line = line;
+                record.level = level;
+                LogArgs<Args...>::pack(record.args, args...);
+                submit(record);
+            } else {
+                Detail::LogMessageString text;
+                text.format(msg, args...);
+                submitFormatted(level, file, line, text.cStr());
+            }
+        }
+
+    protected:
+        /**
+         * @brief Construct a logger whose log calls are handed to submit() rather than formatted in place.
+         */
+        constexpr ILogger(LogLevel level, bool deferred) : level(level), deferred(deferred) {}
+
+        /**
+         * @brief Receive a captured log call. Only called on deferred loggers.
+         */
+        virtual void submit(const LogRecord& record) {
+            (void)record;
+        }
+
+        /**
+         * @brief Receive a log call whose arguments do not fit a record, already formatted into text that only lives
+         *         for the duration of the call. Only called on deferred loggers; the default writes it out in place.
+         */
+        virtual void submitFormatted(LogLevel level, const char* file, size_t line, const char* text) {
+            Detail::writeLogLine(*this, level, "%s", file, line, text);
+        }
+
+    public:
+        constexpr ILogger(LogLevel level) : level(level), deferred(false) {}
+
+        virtual void rawLog(const char* msg) = 0;
+
+        /**
+         * @brief Enter len bytes into the log verbatim. Sinks that carry binary data must override this, the default
+         *         forwards through rawLog and so stops at embedded null bytes.
+         */
+        virtual void rawWrite(const char* data, size_t len) {
+            char chunk[65];
+            while (len) {
+                const size_t n = len < sizeof(chunk) - 1 ? len : sizeof(chunk) - 1;
+                memcpy(chunk, data, n);
+                chunk[n] = '\0';
+                rawLog(chunk);
+                data += n;
+                len -= n;
+            }
+        }
+
+        /**
+         * @brief Format the current timestamp straight into a line being assembled.
+         *
+         * @return How many characters were written, at most capacity.
+         */
+        virtual size_t writeTimestamp(char* out, size_t capacity) {
+            const char* timestamp = getTimestamp();
+            size_t n = 0;
+            while (n < capacity && timestamp[n]) {
+                out[n] = timestamp[n];
+                n++;
+            }
+            return n;
+        }
+
+        LogLevel getLevel() const {
+            return level;
+        }
+
+        void setLevel(LogLevel level) {
+            this->level = level;
+        }
+
+        static const char* levelTag(LogLevel level) {
+            return Detail::levelTag(level);
+        }
+
+        void writeLevel(LogLevel level) {
+            rawLog(levelTag(level));
+        }
+
+        /**
+         * @brief Format a printf style log line, see Format.hpp for the supported conversions. Every argument is
+         *         written as the type it actually has, and the LOG macros check msg against them at compile time.
+         */
         template<typename... Args>
         void log(LogLevel level, const char* msg, const char* file, size_t line, Args... args) {
-            if (level > this->level) return;
-            
-            // Log level string
-            writeLevel(level);
-
-            this->rawLog(getTimestamp());
-            this->rawLog(":");
-            
-            this->rawLog(file);
-            this->rawLog(": ");
-            
-            char lineStr[10];
-            snprintf(lineStr, sizeof(lineStr), "%zu", line);
-            this->rawLog(lineStr);
-            
-            // Parse args
-            char buffer[1024];
-            snprintf(buffer, sizeof(buffer), msg, args...);
-            this->rawLog(buffer);
-            
-            this->rawLog("\n\r");
+            if (!META_LOG_ENABLED(level) || level > this->level) return;
+
+            if (deferred) {
+                defer(level, msg, file, line, args...);
+                return;
+            }
+
+            Detail::writeLogLine(*this, level, msg, file, line, args...);
+        }
+
+        /**
+         * @brief Write bytes into the log as hex, 16 per line. Lines are encoded straight from data and handed to
+         *         rawWrite a few at a time.
+         */
+        void writeHex(const void* data, size_t len) {
+            Detail::writeHexLines(*this, data, len);
         }
 
         template<typename T, size_t N>
         void log_hexdump(const std::array<T, N>& arr, const char* file, size_t line, LogLevel level = LOG_LEVEL_INFO) {
-            size_t bytesWritten = 0;
-            for (auto t : arr) {
-                for (size_t i = 0; i < sizeof(T); i++) {
-                    char hexStr[3];
-                    snprintf(hexStr, sizeof(hexStr), "%02X", (uint8_t)(t >> (i * 8)));
-                    this->rawLog(hexStr);
-                    this->rawLog(" ");
-                    bytesWritten++;
-
-                    if (bytesWritten % 16 == 0) {
-                        this->rawLog("\n\r");
-                    }
-                    else if (bytesWritten % 8 == 0) {
-                        this->rawLog(" ");
-                    }
-                }
-            }
+            (void)file;
+            (void)line;
+            if (!META_LOG_ENABLED(level) || level > this->level)
+                return;
+
+            writeHex(arr.data(), N * sizeof(T));
         }
-            
+
     };
 
-    // default std logger
-    class StdLogger : public ILogger {
+    template<typename... Args>
+    template<size_t... I>
+    void LogArgs<Args...>::emit(ILogger& sink, const LogRecord& record, std::index_sequence<I...>) {
+        (void)record;
+        sink.log(record.level, record.msg, record.file, record.line, read<Args>(record.args, offsetOf(I))...);
+    }
+
+    /**
+     * @brief The default logger, writing to std::cout.
+     *
+     * @tparam Lock Serializes writes from several threads (e.g. SpinLock or MutexLock). The default NullLock adds
+     *               nothing to single threaded builds.
+     */
+    template<typename Lock = NullLock>
+    class BasicStdLogger : public ILogger {
     private:
-        const char* getTimestamp() override {
-            // Return POSIX time as a string
-            time_t now = time(nullptr);
-            struct tm * timeinfo = localtime(&now);
-            static char buffer[80];
-            strftime(buffer, sizeof(buffer), "%H:%M:%S", timeinfo);
-            return buffer;
-        }
+        ITimestamp* timestamp; // Where line timestamps come from
+        Lock mutex;
     public:
-        StdLogger(LogLevel level = LOG_LEVEL_DEBUG) : ILogger(level) {}
+        constexpr BasicStdLogger(LogLevel level = LOG_LEVEL_DEBUG, ITimestamp& timestamp = Timestamps::wallClock)
+            : ILogger(level), timestamp(&timestamp), mutex() {}
+
+        size_t writeTimestamp(char* out, size_t capacity) override {
+            return timestamp->write(out, capacity);
+        }
+
+        void setTimestamp(ITimestamp& timestamp) {
+            this->timestamp = &timestamp;
+        }
 
         void rawLog(const char* msg) override {
+            LockGuard<Lock> guard(mutex);
             std::cout << msg;
         }
+
+        void rawWrite(const char* data, size_t len) override {
+            LockGuard<Lock> guard(mutex);
+            std::cout.write(data, len);
+        }
+    };
+
+    typedef BasicStdLogger<> StdLogger;
+
+    /**
+     * @brief The base of a logger bound at compile time (see META_LOGGER_TYPE), for single sink builds. Lines are
+     *         assembled exactly as ILogger does, but every call into the sink is direct, so a LOG call can inline
+     *         down to formatting and a single write.
+     *
+     * Derived implements:
+     *
+     *   void rawWrite(const char* data, size_t len);
+     *
+     * and may hide writeTimestamp(out, capacity) to put a timestamp in each line header.
+     *
+     * @tparam Derived The concrete logger (CRTP).
+     */
+    template<typename Derived>
+    class BasicLogger {
+    private:
+        LogLevel level;
+
+        Derived& derived() {
+            return static_cast<Derived&>(*this);
+        }
+
+    public:
+        constexpr BasicLogger(LogLevel level = LOG_LEVEL_DEBUG) : level(level) {}
+
+        /**
+         * @brief Format the current timestamp straight into a line being assembled. The default writes none.
+         *
+         * @return How many characters were written, at most capacity.
+         */
+        size_t writeTimestamp(char* out, size_t capacity) {
+            (void)out;
+            (void)capacity;
+            return 0;
+        }
+
+        /**
+         * @brief Enter text into the log without headers, newlines, or carriage returns.
+         */
+        void rawLog(const char* msg) {
+            derived().rawWrite(msg, strlen(msg));
+        }
+
+        LogLevel getLevel() const {
+            return level;
+        }
+
+        void setLevel(LogLevel level) {
+            this->level = level;
+        }
+
+        /**
+         * @brief Format a printf style log line, as ILogger::log.
+         */
+        template<typename... Args>
+        void log(LogLevel level, const char* msg, const char* file, size_t line, Args... args) {
+            if (!META_LOG_ENABLED(level) || level > this->level) return;
+
+            Detail::writeLogLine(derived(), level, msg, file, line, args...);
+        }
+
+        void writeHex(const void* data, size_t len) {
+            Detail::writeHexLines(derived(), data, len);
+        }
+
+        template<typename T, size_t N>
+        void log_hexdump(const std::array<T, N>& arr, const char* file, size_t line, LogLevel level = LOG_LEVEL_INFO) {
+            (void)file;
+            (void)line;
+            if (!META_LOG_ENABLED(level) || level > this->level)
+                return;
+
+            writeHex(arr.data(), N * sizeof(T));
+        }
     };
 
     // If you find youself using this class directly, you're bad and you should feel bad.
+    //
+    // Both the default logger and the pointer to the active one are constant-initialized, so there is no first-use
+    // check, no heap allocation and no initialization race.
     class LogBroker {
     private:
-        static inline ILogger* logger;
+        static inline StdLogger defaultLogger{LOG_LEVEL_DEBUG};
+        static inline std::atomic<ILogger*> logger{&defaultLogger};
 
     public:
+        /**
+         * @brief Route logging into l, or back into the default logger if l is null. The logger must outlive its use,
+         *         so it should normally be a static instance.
+         */
         template<typename T>
-        static constexpr void setLogger(T* l = nullptr) {
-            logger = l ? l : new StdLogger(LOG_LEVEL_DEBUG);
+        static void setLogger(T* l) {
+            logger.store(l ? static_cast<ILogger*>(l) : &defaultLogger, std::memory_order_release);
+        }
+
+        template<typename T>
+        static void setLogger(T& l) {
+            setLogger(&l);
+        }
+
+        static void setLogger(std::nullptr_t) {
+            logger.store(&defaultLogger, std::memory_order_release);
         }
 
         static inline ILogger* getLogger() {
-            if (logger == nullptr) {
-                logger = new StdLogger(LOG_LEVEL_DEBUG);
-            }
+            return logger.load(std::memory_order_acquire);
+        }
+    };
+
+    /**
+     * @brief Holds the one logger of a compile-time bound build. L must be default constructible; specialize this for
+     *         a logger that needs constructor arguments.
+     *
+     * @tparam L A BasicLogger.
+     */
+    template<typename L>
+    class StaticLogBroker {
+    private:
+        static inline L logger{};
+
+    public:
+        static L& getLogger() {
             return logger;
         }
     };
 
+    /**
+     * @brief The logger the LOG macros write into, as a reference.
+     */
+#ifdef META_LOGGER_TYPE
+    #define META_LOGGER() (Meta::StaticLogBroker<META_LOGGER_TYPE>::getLogger())
+#else
+    #define META_LOGGER() (*Meta::LogBroker::getLogger())
+#endif
+
+    /**
+     * @brief Route logging into another ILogger. Builds with META_LOGGER_TYPE log into that type only, and this just
+     *         changes what LogBroker::getLogger() returns.
+     */
     #define SET_LOGGER(logger) Meta::LogBroker::setLogger(logger)
 
     /**
      * @brief The current logging level
      */
-    #define LOG_LEVEL LogBroker::getLogger()->getLevel()
-    #define SET_LOG_LEVEL(level) LogBroker::getLogger()->setLevel(level)
+    #define LOG_LEVEL META_LOGGER().getLevel()
+    #define SET_LOG_LEVEL(level) META_LOGGER().setLevel(level)
 
     /**
      * @brief Enter text into the log without headers, newlines, or carriage returns.
      */
-    #define RAW_LOG(msg) LogBroker::getLogger()->rawLog(msg)
+    #define RAW_LOG(msg) META_LOGGER().rawLog(msg)
 
-    #define LOG(level, msg, ...)  Meta::LogBroker::getLogger()->log(level, msg, __FILE__, __LINE__, ##__VA_ARGS__)
-    #define LOG_ERROR(msg, ...)   Meta::LogBroker::getLogger()->log(Meta::LOG_LEVEL_ERROR, msg, __FILE__, __LINE__, ##__VA_ARGS__)
-    #define LOG_WARNING(msg, ...) Meta::LogBroker::getLogger()->log(Meta::LOG_LEVEL_WARNING, msg, __FILE__, __LINE__, ##__VA_ARGS__)
-    #define LOG_INFO(msg, ...)    Meta::LogBroker::getLogger()->log(Meta::LOG_LEVEL_INFO, msg, __FILE__, __LINE__, ##__VA_ARGS__)
-    #define LOG_DEBUG(msg, ...)   Meta::LogBroker::getLogger()->log(Meta::LOG_LEVEL_DEBUG, msg, __FILE__, __LINE__, ##__VA_ARGS__)
+    /**
+     * @brief Log a printf style message. msg must be a string literal, it is checked against the arguments' types at
+     *         compile time (see META_CHECK_FORMAT).
+     */
+    #define LOG(level, msg, ...)  (META_CHECK_FORMAT(msg, ##__VA_ARGS__), \
+        META_LOG_ENABLED(level) ? META_LOGGER().log(level, msg, __FILE__, __LINE__, ##__VA_ARGS__) : (void)0)
+    #define LOG_ERROR(msg, ...)   LOG(Meta::LOG_LEVEL_ERROR, msg, ##__VA_ARGS__)
+    #define LOG_WARNING(msg, ...) LOG(Meta::LOG_LEVEL_WARNING, msg, ##__VA_ARGS__)
+    #define LOG_INFO(msg, ...)    LOG(Meta::LOG_LEVEL_INFO, msg, ##__VA_ARGS__)
+    #define LOG_DEBUG(msg, ...)   LOG(Meta::LOG_LEVEL_DEBUG, msg, ##__VA_ARGS__)
 
 }
+
+#ifdef META_LOGGER_HEADER
+#include META_LOGGER_HEADER
+#endif
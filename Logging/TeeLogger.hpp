@@ -0,0 +1,224 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include "ILogger.hpp"
+#include "../Errors/ErrorUnion.hpp"
+#include "../Errors/Errors.hpp"
+#include "../Structures/Buffer.hpp"
+#include "../Structures/BufferView.hpp"
+#include "../Utils/Locks.hpp"
+
+/**
+ * @brief The clock log rate limits are measured in: a type with an unsigned Tick typedef and a static Tick now(),
+ *         like META_TRACE_CLOCK. Ticks may wrap. On a target this is typically the millisecond system tick.
+ */
+#ifndef META_LOG_RATE_CLOCK
+#define META_LOG_RATE_CLOCK Meta::MillisecondClock
+#endif
+
+namespace Meta {
+    /**
+     * @brief std::chrono::steady_clock in milliseconds.
+     */
+    struct MillisecondClock {
+        typedef uint32_t Tick;
+
+        static Tick now() {
+            return (Tick)std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+    };
+
+    /**
+     * @brief A token bucket: up to burst events at once, refilled by one every interval ticks. Integer only, O(1)
+     *         per event, and never blocks.
+     *
+     * @tparam Clock Where ticks come from, see META_LOG_RATE_CLOCK.
+     */
+    template<typename Clock = META_LOG_RATE_CLOCK>
+    class TokenBucket {
+    private:
+        typedef typename Clock::Tick Tick;
+
+        uint32_t burst; // The most tokens the bucket holds, 0 if unlimited
+        Tick interval; // Ticks per refilled token
+        uint32_t tokens;
+        Tick last; // When the bucket was last refilled, less the remainder of a partial token
+
+    public:
+        /**
+         * @brief Instantiate a full bucket. The default one never runs out.
+         */
+        constexpr TokenBucket(uint32_t burst = 0, Tick interval = 1)
+            : burst(burst), interval(interval ? interval : 1), tokens(burst), last(0) {}
+
+        /**
+         * @brief Take a token if there is one.
+         *
+         * @return Whether the event may go ahead.
+         */
+        bool take() {
+            if (burst == 0) {
+                return true;
+            }
+            const Tick now = Clock::now();
+            const Tick refill = (Tick)(now - last) / interval;
+            if (refill) {
+                tokens = refill >= burst - tokens ? burst : tokens + (uint32_t)refill;
+                last = tokens == burst ? now : (Tick)(last + refill * interval);
+            }
+            if (tokens == 0) {
+                return false;
+            }
+            tokens--;
+            return true;
+        }
+    };
+
+    /**
+     * @brief A logger that fans every log call out to several sinks (e.g. a UART, a FlightRecorder and network
+     *         telemetry), each with its own level and rate limit.
+     *
+     * Calls are captured as records and handed to each sink that passes, which formats its own line, so sinks keep
+     *  their own timestamps. A sink that is an AsyncLogger only queues the record: wrap slow sinks in one so they
+     *  cannot stall the others. A rate limited sink drops lines before any formatting is done, so a burst of errors
+     *  costs it next to nothing, and it is told how many it missed with its next line. Calls whose arguments do not
+     *  fit a record are formatted once and handed to each sink as text.
+     *
+     * The tee's own level should be the most verbose of its sinks'; calls above it are rejected before capture.
+     *
+     * @tparam MaxSinks How many sinks can be attached.
+     * @tparam Lock Serializes log calls from several threads (e.g. SpinLock or MutexLock). It is held while sinks
+     *               write, so sinks must not log back into the tee.
+     * @tparam Clock Where rate limit ticks come from, see META_LOG_RATE_CLOCK.
+     */
+    template<size_t MaxSinks = 4, typename Lock = NullLock, typename Clock = META_LOG_RATE_CLOCK>
+    class TeeLogger : public ILogger {
+    private:
+        typedef struct {
+            ILogger* logger;
+            LogLevel level; // The least severe level this sink takes
+            TokenBucket<Clock> limit;
+            size_t dropped; // How many lines the rate limit dropped since the sink last took one
+        } Sink;
+
+        Buffer<Sink, MaxSinks> sinks;
+        Lock mutex;
+
+        Sink* sinkOf(const ILogger& logger) {
+            for (size_t i = 0; i < sinks.size(); i++) {
+                if (sinks[i].logger == &logger) {
+                    return &sinks[i];
+                }
+            }
+            return nullptr;
+        }
+
+        /**
+         * @brief Whether sink takes a line at level, telling it about lines its rate limit dropped if so.
+         */
+        static bool admit(Sink& sink, LogLevel level) {
+            if (level > sink.level) {
+                return false;
+            }
+            if (!sink.limit.take()) {
+                sink.dropped++;
+                return false;
+            }
+            if (sink.dropped) {
+                // At the level of the line that let it through, which this sink is known to take
+                sink.logger->log(level, "Rate limited %zu log lines", __FILE__, __LINE__, sink.dropped);
+                sink.dropped = 0;
+            }
+            return true;
+        }
+
+        void submit(const LogRecord& record) override {
+            LockGuard<Lock> guard(mutex);
+            for (size_t i = 0; i < sinks.size(); i++) {
+                if (admit(sinks[i], record.level)) {
+                    record.emit(*sinks[i].logger, record);
+                }
+            }
+        }
+
+        void submitFormatted(LogLevel level, const char* file, size_t line, const char* text) override {
+            LockGuard<Lock> guard(mutex);
+            for (size_t i = 0; i < sinks.size(); i++) {
+                if (admit(sinks[i], level)) {
+                    sinks[i].logger->log(level, "%s", file, line, text);
+                }
+            }
+        }
+
+    public:
+        TeeLogger(LogLevel level = LOG_LEVEL_DEBUG) : ILogger(level, true), sinks(), mutex() {}
+
+        /**
+         * @brief Attach a sink. It must outlive the tee.
+         *
+         * @param level The least severe level the sink takes.
+         * @param burst How many lines the sink takes at once before it is rate limited, 0 for no limit.
+         * @param interval How many Clock ticks it takes to earn back one line.
+         * @return An error if MaxSinks sinks are already attached, void otherwise.
+         */
+        ErrorUnion<void> addSink(ILogger& logger, LogLevel level = LOG_LEVEL_DEBUG, uint32_t burst = 0,
+                                 typename Clock::Tick interval = 1) {
+            LockGuard<Lock> guard(mutex);
+            if (sinks.size() >= MaxSinks) {
+                return ErrorUnion<void>(MAKE_ERROR(BUFFER_ERROR_OVERRUN, "Too many sinks"));
+            }
+            return sinks.push_back(Sink{&logger, level, TokenBucket<Clock>(burst, interval), 0});
+        }
+
+        /**
+         * @brief Change the level an attached sink takes.
+         *
+         * @return An error if logger is not attached, void otherwise.
+         */
+        ErrorUnion<void> setSinkLevel(const ILogger& logger, LogLevel level) {
+            LockGuard<Lock> guard(mutex);
+            Sink* sink = sinkOf(logger);
+            if (!sink) {
+                return ErrorUnion<void>(MAKE_ERROR(BUFFER_ERROR_NOT_FOUND, "Sink not attached"));
+            }
+            sink->level = level;
+            return ErrorUnion<void>();
+        }
+
+        /**
+         * @brief How many lines an attached sink's rate limit has dropped since it last took one.
+         */
+        ErrorUnion<size_t> droppedBy(const ILogger& logger) {
+            LockGuard<Lock> guard(mutex);
+            const Sink* sink = sinkOf(logger);
+            if (!sink) {
+                return ErrorUnion<size_t>(MAKE_ERROR(BUFFER_ERROR_NOT_FOUND, "Sink not attached"));
+            }
+            return ErrorUnion<size_t>(sink->dropped);
+        }
+
+        /**
+         * @brief Raw writes (hex dumps, token and trace records) go to every sink, unfiltered.
+         */
+        void rawLog(const char* msg) override {
+            LockGuard<Lock> guard(mutex);
+            for (size_t i = 0; i < sinks.size(); i++) {
+                sinks[i].logger->rawLog(msg);
+            }
+        }
+
+        void rawWrite(const char* data, size_t len) override {
+            LockGuard<Lock> guard(mutex);
+            for (size_t i = 0; i < sinks.size(); i++) {
+                sinks[i].logger->rawWrite(data, len);
+            }
+        }
+
+        size_t sinkCount() const {
+            return sinks.size();
+        }
+    };
+}
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include "../Utils/Format.hpp"
+
+/**
+ * @brief The storage class of the per-thread timestamp caches. Targets without thread local storage can define it
+ *         empty, as long as only one context formats timestamps.
+ */
+#ifndef META_THREAD_LOCAL
+#define META_THREAD_LOCAL thread_local
+#endif
+
+namespace Meta {
+    /**
+     * @brief A source of log line timestamps.
+     */
+    class ITimestamp {
+    public:
+        /**
+         * @brief Format the current time into out.
+         *
+         * @return How many characters were written, at most capacity. The timestamp is not null terminated.
+         */
+        virtual size_t write(char* out, size_t capacity) = 0;
+    };
+
+    namespace Detail {
+        /**
+         * @brief Write value as exactly digits decimal digits, zero padded.
+         */
+        inline void writeDigits(char* out, uint32_t value, size_t digits) {
+            for (size_t i = digits; i >= 2; i -= 2) {
+                memcpy(out + i - 2, &Format::Detail::DECIMAL_PAIRS[2 * (value % 100)], 2);
+                value /= 100;
+            }
+            if (digits & 1) {
+                out[0] = (char)('0' + value % 10);
+            }
+        }
+
+        /**
+         * @brief Join a cached per-second prefix, a '.' and the sub-second digits into out.
+         */
+        inline size_t joinTimestamp(char* out, size_t capacity, const char* prefix, size_t prefixLen,
+                                    uint32_t fraction, size_t digits) {
+            char stamp[32];
+            memcpy(stamp, prefix, prefixLen);
+            stamp[prefixLen] = '.';
+            writeDigits(stamp + prefixLen + 1, fraction, digits);
+            const size_t len = prefixLen + 1 + digits;
+            const size_t n = len < capacity ? len : capacity;
+            memcpy(out, stamp, n);
+            return n;
+        }
+    }
+
+    /**
+     * @brief Local wall clock time as "HH:MM:SS.mmm".
+     *
+     * The "HH:MM:SS" prefix is only rebuilt (via localtime_r, which may lock) once a second per thread; every other
+     *  call formats the milliseconds alone.
+     */
+    class WallClockTimestamp : public ITimestamp {
+    private:
+        typedef struct {
+            time_t second;
+            char prefix[8];
+        } Cache;
+
+    public:
+        constexpr WallClockTimestamp() {}
+
+        size_t write(char* out, size_t capacity) override {
+            static META_THREAD_LOCAL Cache cache = {(time_t)-1, {}};
+
+            const int64_t us = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+            const time_t second = (time_t)(us / 1000000);
+
+            if (second != cache.second) {
+                struct tm local;
+#if defined(_WIN32)
+                localtime_s(&local, &second);
+#else
+                localtime_r(&second, &local);
+#endif
+                Detail::writeDigits(cache.prefix, (uint32_t)local.tm_hour, 2);
+                cache.prefix[2] = ':';
+                Detail::writeDigits(cache.prefix + 3, (uint32_t)local.tm_min, 2);
+                cache.prefix[5] = ':';
+                Detail::writeDigits(cache.prefix + 6, (uint32_t)local.tm_sec, 2);
+                cache.second = second;
+            }
+            return Detail::joinTimestamp(out, capacity, cache.prefix, sizeof(cache.prefix),
+                                         (uint32_t)(us % 1000000 / 1000), 3);
+        }
+    };
+
+    /**
+     * @brief Time since an unspecified monotonic epoch (usually boot) as "<seconds>.uuuuuu". Never jumps, so it
+     *         orders lines correctly across wall clock changes.
+     *
+     * The seconds prefix is only rebuilt once a second per thread.
+     */
+    class MonotonicTimestamp : public ITimestamp {
+    private:
+        typedef struct {
+            uint64_t second;
+            size_t length;
+            char prefix[20];
+        } Cache;
+
+    public:
+        constexpr MonotonicTimestamp() {}
+
+        size_t write(char* out, size_t capacity) override {
+            static META_THREAD_LOCAL Cache cache = {UINT64_MAX, 0, {}};
+
+            const uint64_t us = (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+            const uint64_t second = us / 1000000;
+
+            if (second != cache.second) {
+                char digits[20];
+                size_t count = 0;
+                uint64_t value = second;
+                do {
+                    digits[count++] = (char)('0' + value % 10);
+                    value /= 10;
+                } while (value);
+                for (size_t i = 0; i < count; i++) {
+                    cache.prefix[i] = digits[count - 1 - i];
+                }
+                cache.length = count;
+                cache.second = second;
+            }
+            return Detail::joinTimestamp(out, capacity, cache.prefix, cache.length, (uint32_t)(us % 1000000), 6);
+        }
+    };
+
+    /**
+     * @brief Shared default instances. Providers keep no per-instance state, so one of each is enough.
+     */
+    class Timestamps {
+    public:
+        static inline WallClockTimestamp wallClock;
+        static inline MonotonicTimestamp monotonic;
+    };
+}
@@ -0,0 +1,249 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include "ILogger.hpp"
+#include "../Errors/Errors.hpp"
+#include "../Structures/StaticString.hpp"
+
+/**
+ * @brief The largest binary record a tokenized log call emits, header included. String arguments are truncated to fit.
+ */
+#ifndef META_LOG_TOKEN_RECORD_SIZE
+#define META_LOG_TOKEN_RECORD_SIZE 64
+#endif
+
+namespace Meta {
+    /**
+     * @brief A format string registered under an id.
+     */
+    typedef struct LogToken {
+        size_t id;
+        const char* msg;
+        const char* file;
+        const char* signature; // One kind/size pair per argument, e.g. "i4u8s0"
+        const struct LogToken* next;
+    } LogToken;
+
+    /**
+     * @brief The table of every tokenized format string in the program. Tokens link themselves in during static
+     *         initialization, so the table is complete by the time main() runs.
+     *
+     * Ids are handed out in registration order, so like error codes they are unique across the whole program but may
+     *  change between builds; decode records with the table exported by the same build. Records carry 16 bit ids, so
+     *  tokens past MAX_TOKENS are rejected: they stay out of the table and their sites emit nothing.
+     */
+    class LogTokens {
+    private:
+        static inline const LogToken* head = nullptr;
+        static inline size_t count = 0;
+        static inline size_t rejectedCount = 0;
+
+    public:
+        static constexpr size_t MAX_TOKENS = 0x10000;
+        static constexpr size_t REJECTED = (size_t)-1; // The id of a rejected token
+
+        /**
+         * @return Whether the token was registered, false if it was rejected.
+         */
+        static bool registerToken(LogToken& token) {
+            if (count >= MAX_TOKENS) {
+                token.id = REJECTED;
+                rejectedCount++;
+                return false;
+            }
+            token.id = count++;
+            token.next = head;
+            head = &token;
+            return true;
+        }
+
+        /**
+         * @brief How many tokens are registered.
+         */
+        static size_t size() {
+            return count;
+        }
+
+        /**
+         * @brief How many tokens were rejected for want of ids, 0 unless the program has more than MAX_TOKENS sites.
+         */
+        static size_t rejected() {
+            return rejectedCount;
+        }
+
+        static const LogToken* first() {
+            return head;
+        }
+
+        /**
+         * @brief Write the table into a logger as one "<id>\t<signature>\t<file>\t<format>" line per token, for a host
+         *         tool to decode binary records with.
+         */
+        template<typename Logger>
+        static void exportTable(Logger& logger) {
+            for (const LogToken* token = head; token; token = token->next) {
+                StaticString<24> idStr;
+                idStr.format("%zu\t", token->id);
+                logger.rawLog(idStr.cStr());
+                logger.rawLog(token->signature);
+                logger.rawLog("\t");
+                logger.rawLog(token->file);
+                logger.rawLog("\t");
+                logger.rawLog(token->msg);
+                logger.rawLog("\n");
+            }
+        }
+    };
+
+    /**
+     * @brief Encodes tokenized log arguments. Arithmetic values, enums and pointers are written as their raw (host
+     *         endian) bytes; C strings are written as a length byte followed by as many characters as fit.
+     */
+    template<typename Arg>
+    class TokenArg {
+    private:
+        static constexpr bool isString = std::is_same<Arg, const char*>::value || std::is_same<Arg, char*>::value;
+
+    public:
+        static_assert(isString || std::is_arithmetic<Arg>::value || std::is_enum<Arg>::value || std::is_pointer<Arg>::value,
+                      "Tokenized log arguments must be arithmetic, enums, pointers or C strings.");
+
+        static constexpr char kind() {
+            if (isString) return 's';
+            if (std::is_floating_point<Arg>::value) return 'f';
+            if (std::is_pointer<Arg>::value) return 'p';
+            if (std::is_signed<Arg>::value) return 'i';
+            return 'u';
+        }
+
+        static constexpr char size() {
+            return isString ? '0' : (char)('0' + sizeof(Arg));
+        }
+
+        /**
+         * @brief The fewest bytes the argument encodes to: an empty string is just its length byte.
+         */
+        static constexpr size_t minSize() {
+            return isString ? 1 : sizeof(Arg);
+        }
+
+        /**
+         * @param capacity At least minSize().
+         * @return How many bytes were written into out.
+         */
+        static size_t encode(uint8_t* out, size_t capacity, const Arg& arg) {
+            if constexpr (isString) {
+                size_t len = arg ? strlen(arg) : 0;
+                if (len > capacity - 1) len = capacity - 1;
+                if (len > 0xFF) len = 0xFF;
+                out[0] = (uint8_t)len;
+                memcpy(out + 1, arg, len);
+                return len + 1;
+            } else {
+                (void)capacity;
+                memcpy(out, &arg, sizeof(Arg));
+                return sizeof(Arg);
+            }
+        }
+    };
+
+    /**
+     * @brief A single tokenized call site. Its token is registered, and given its id, during static initialization.
+     *
+     * @tparam Site A type exposing the call site's format(), file() and constexpr line(), unique to the site.
+     */
+    template<typename Site, typename... Args>
+    class TokenSite {
+    private:
+        static constexpr std::array<char, 2 * sizeof...(Args) + 1> makeSignature() {
+            std::array<char, 2 * sizeof...(Args) + 1> sig = {};
+            constexpr char kinds[] = {TokenArg<Args>::kind()..., '\0'};
+            constexpr char sizes[] = {TokenArg<Args>::size()..., '\0'};
+            for (size_t i = 0; i < sizeof...(Args); i++) {
+                sig[2 * i] = kinds[i];
+                sig[2 * i + 1] = sizes[i];
+            }
+            return sig;
+        }
+
+        static constexpr std::array<char, 2 * sizeof...(Args) + 1> sig = makeSignature();
+        static inline LogToken token = {0, Site::format(), Site::file(), sig.data(), nullptr};
+        static inline const bool registered = LogTokens::registerToken(token);
+
+    public:
+        static_assert(Site::line() <= 0xFFFF, "Tokenized log calls past line 65535 do not fit the record header.");
+
+        /**
+         * @brief Write a binary [id:u16][level:u8][payload length:u8][line:u16][args...] record into the logger.
+         */
+        template<typename Logger>
+        static void log(Logger& logger, LogLevel level, Args... args) {
+            (void)&registered;
+            if (level > logger.getLevel() || token.id == LogTokens::REJECTED)
+                return;
+
+            uint8_t record[META_LOG_TOKEN_RECORD_SIZE];
+            constexpr size_t header = 6;
+            // Every argument always fits in its smallest form, so the payload always matches the signature
+            constexpr size_t minPayload = (size_t(0) + ... + TokenArg<Args>::minSize());
+            static_assert(META_LOG_TOKEN_RECORD_SIZE >= header + minPayload,
+                          "The arguments of this tokenized log call do not fit META_LOG_TOKEN_RECORD_SIZE.");
+
+            // Strings only take what is left once the arguments after them are reserved
+            size_t len = header;
+            size_t reserved = minPayload;
+            ((reserved -= TokenArg<Args>::minSize(),
+              len += TokenArg<Args>::encode(record + len, sizeof(record) - len - reserved, args)), ...);
+
+            const size_t id = token.id;
+            constexpr size_t line = Site::line();
+            record[0] = (uint8_t)(id & 0xFF);
+            record[1] = (uint8_t)(id >> 8);
+            record[2] = (uint8_t)level;
+            record[3] = (uint8_t)(len - header);
+            record[4] = (uint8_t)(line & 0xFF);
+            record[5] = (uint8_t)((line >> 8) & 0xFF);
+            logger.rawWrite(reinterpret_cast<const char*>(record), len);
+        }
+    };
+
+    /**
+     * @brief Log through a tokenized call site. Sites that are compiled out are never instantiated, so their tokens
+     *         do not make it into the table (or the binary).
+     */
+    template<typename Site, bool Enabled = true, typename Logger, typename... Args>
+    inline void tokenLog(Logger& logger, LogLevel level, Args... args) {
+        if constexpr (Enabled) {
+            if (META_LOG_ENABLED(level)) {
+                TokenSite<Site, Args...>::log(logger, level, args...);
+            }
+        }
+    }
+
+    #define META_LOG_TOKEN_SITE(enabled, level, msg, ...) do { \
+            struct MetaTokenSite { \
+                static const char* format() { return msg; } \
+                static const char* file() { return SIMPLIFY_FILE_NAME(__FILE__); } \
+                static constexpr size_t line() { return __LINE__; } \
+            }; \
+            Meta::tokenLog<MetaTokenSite, enabled>(META_LOGGER(), level, ##__VA_ARGS__); \
+        } while (0)
+
+    /**
+     * @brief Log a format string as a compact binary record keyed by its token id rather than as text.
+     */
+    #define LOG_TOKEN(level, msg, ...)  META_LOG_TOKEN_SITE(true, level, msg, ##__VA_ARGS__)
+    #define LOG_TOKEN_ERROR(msg, ...)   META_LOG_TOKEN_SITE(META_LOG_ENABLED(Meta::LOG_LEVEL_ERROR), Meta::LOG_LEVEL_ERROR, msg, ##__VA_ARGS__)
+    #define LOG_TOKEN_WARNING(msg, ...) META_LOG_TOKEN_SITE(META_LOG_ENABLED(Meta::LOG_LEVEL_WARNING), Meta::LOG_LEVEL_WARNING, msg, ##__VA_ARGS__)
+    #define LOG_TOKEN_INFO(msg, ...)    META_LOG_TOKEN_SITE(META_LOG_ENABLED(Meta::LOG_LEVEL_INFO), Meta::LOG_LEVEL_INFO, msg, ##__VA_ARGS__)
+    #define LOG_TOKEN_DEBUG(msg, ...)   META_LOG_TOKEN_SITE(META_LOG_ENABLED(Meta::LOG_LEVEL_DEBUG), Meta::LOG_LEVEL_DEBUG, msg, ##__VA_ARGS__)
+
+    /**
+     * @brief Write the token string table into the log.
+     */
+    #define LOG_TOKEN_TABLE() Meta::LogTokens::exportTable(META_LOGGER())
+}
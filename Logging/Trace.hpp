@@ -0,0 +1,267 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "ILogger.hpp"
+#include "../Errors/Errors.hpp"
+#include "../Structures/StaticString.hpp"
+#include "../Utils/ArrayUtils.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#elif !(defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__))
+#include <chrono>
+#endif
+
+/**
+ * @brief Set to 1 to compile META_TRACE_SCOPE and META_COUNTER sites in. When 0 (the default) they expand to nothing.
+ */
+#ifndef META_TRACE_ENABLE
+#define META_TRACE_ENABLE 0
+#endif
+
+/**
+ * @brief The clock trace scopes are timed with: a type with an unsigned Tick typedef and a static Tick now(). Ticks
+ *         may wrap, elapsed times are taken modulo the width of Tick.
+ */
+#ifndef META_TRACE_CLOCK
+#define META_TRACE_CLOCK Meta::CycleClock
+#endif
+
+namespace Meta {
+    /**
+     * @brief The cheapest cycle counter of the target: the TSC on x86, the DWT cycle counter on Cortex-M3 and up,
+     *         otherwise std::chrono::steady_clock in nanoseconds.
+     */
+    struct CycleClock {
+#if defined(__x86_64__) || defined(__i386__)
+        typedef uint64_t Tick;
+
+        static Tick now() {
+            return __rdtsc();
+        }
+
+        static void enable() {}
+#elif defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__)
+        typedef uint32_t Tick;
+
+        static Tick now() {
+            return *reinterpret_cast<volatile uint32_t*>(0xE0001004); // DWT->CYCCNT
+        }
+
+        /**
+         * @brief The DWT cycle counter is off out of reset; call this once before tracing.
+         */
+        static void enable() {
+            *reinterpret_cast<volatile uint32_t*>(0xE000EDFC) |= (1u << 24); // CoreDebug->DEMCR |= TRCENA
+            *reinterpret_cast<volatile uint32_t*>(0xE0001004) = 0;
+            *reinterpret_cast<volatile uint32_t*>(0xE0001000) |= 1u; // DWT->CTRL |= CYCCNTENA
+        }
+#else
+        typedef uint64_t Tick;
+
+        static Tick now() {
+            return (Tick)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        static void enable() {}
+#endif
+    };
+
+    typedef enum {
+        TRACE_SCOPE = 0,
+        TRACE_COUNTER = 1,
+    } TraceKind;
+
+    /**
+     * @brief The statistics of one instrumented site. Updates are not atomic, so a site hit concurrently from
+     *         several contexts may lose samples.
+     */
+    typedef struct TracePoint {
+        size_t id;
+        TraceKind kind;
+        const char* name;
+        const char* file;
+        uint32_t count; // Scope entries, or the counter's value
+        uint64_t total; // Total ticks spent in the scope
+        uint32_t max; // The longest single pass through the scope, saturated at 2^32 - 1 ticks
+        struct TracePoint* next;
+    } TracePoint;
+
+    /**
+     * @brief The table of every trace site in the program. Sites link themselves in during static initialization,
+     *         so the table is complete by the time main() runs.
+     *
+     * Ids are handed out in registration order, so like error codes they are unique across the whole program but may
+     *  change between builds; decode records with the table exported by the same build. A site inside a template
+     *  registers once per instantiation, each under its own id but with the same name and file.
+     */
+    class Traces {
+    private:
+        static inline TracePoint* head = nullptr;
+        static inline size_t count = 0;
+
+    public:
+        /**
+         * @brief The size of a flushed record: [id:u16][kind:u8][count:u32][total:u64][max:u32], little endian.
+         */
+        static constexpr size_t RECORD_SIZE = 2 + 1 + 4 + 8 + 4;
+
+        static bool registerPoint(TracePoint& point) {
+            point.id = count++;
+            point.next = head;
+            head = &point;
+            return true;
+        }
+
+        static const TracePoint* first() {
+            return head;
+        }
+
+        /**
+         * @brief How many sites are registered.
+         */
+        static size_t size() {
+            return count;
+        }
+
+        /**
+         * @brief Write every site's statistics into a logger as binary records, in a single rawWrite per record.
+         */
+        template<typename Logger>
+        static void flush(Logger& logger) {
+            for (const TracePoint* point = head; point; point = point->next) {
+                uint8_t record[RECORD_SIZE];
+                storeBytes<uint16_t, Endian::Little>((uint16_t)point->id, record);
+                record[2] = (uint8_t)point->kind;
+                storeBytes<uint32_t, Endian::Little>(point->count, record + 3);
+                storeBytes<uint64_t, Endian::Little>(point->total, record + 7);
+                storeBytes<uint32_t, Endian::Little>(point->max, record + 15);
+                logger.rawWrite(reinterpret_cast<const char*>(record), sizeof(record));
+            }
+        }
+
+        /**
+         * @brief Write the table into a logger as one "<id>\t<kind>\t<file>\t<name>" line per site, for a host tool
+         *         to decode flushed records with.
+         */
+        template<typename Logger>
+        static void exportTable(Logger& logger) {
+            for (const TracePoint* point = head; point; point = point->next) {
+                StaticString<24> idStr;
+                idStr.format("%zu\t", point->id);
+                logger.rawLog(idStr.cStr());
+                logger.rawLog(point->kind == TRACE_SCOPE ? "scope\t" : "counter\t");
+                logger.rawLog(point->file);
+                logger.rawLog("\t");
+                logger.rawLog(point->name);
+                logger.rawLog("\n");
+            }
+        }
+
+        /**
+         * @brief Zero every site's statistics.
+         */
+        static void reset() {
+            for (TracePoint* point = head; point; point = point->next) {
+                point->count = 0;
+                point->total = 0;
+                point->max = 0;
+            }
+        }
+    };
+
+    /**
+     * @brief A single trace site. Its point is registered, and given its id, during static initialization.
+     *
+     * @tparam Site A type exposing the site's name() and file(), unique to the site.
+     */
+    template<typename Site, TraceKind Kind>
+    class TraceSite {
+    private:
+        static inline TracePoint tracePoint = {0, Kind, Site::name(), Site::file(), 0, 0, 0, nullptr};
+        static inline const bool registered = Traces::registerPoint(tracePoint);
+
+    public:
+        static TracePoint& point() {
+            (void)&registered;
+            return tracePoint;
+        }
+    };
+
+    /**
+     * @brief Times its own lifetime into a trace point.
+     */
+    template<typename Clock = META_TRACE_CLOCK>
+    class TraceScope {
+    private:
+        TracePoint& point;
+        const typename Clock::Tick start;
+
+    public:
+        explicit TraceScope(TracePoint& point) : point(point), start(Clock::now()) {}
+
+        TraceScope(const TraceScope& other) = delete;
+        TraceScope& operator=(const TraceScope& other) = delete;
+
+        ~TraceScope() {
+            const typename Clock::Tick elapsed = (typename Clock::Tick)(Clock::now() - start);
+            uint32_t clamped = (uint32_t)elapsed;
+            if constexpr (sizeof(elapsed) > sizeof(uint32_t)) {
+                clamped = elapsed > 0xFFFFFFFFu ? 0xFFFFFFFFu : clamped;
+            }
+            point.count++;
+            point.total += elapsed;
+            if (clamped > point.max) {
+                point.max = clamped;
+            }
+        }
+    };
+
+    #define META_TRACE_CONCAT_(a, b) a##b
+    #define META_TRACE_CONCAT(a, b) META_TRACE_CONCAT_(a, b)
+
+    #define META_TRACE_SITE_TYPE(siteName) \
+        struct META_TRACE_CONCAT(MetaTraceSite, __LINE__) { \
+            static const char* name() { return siteName; } \
+            static const char* file() { return SIMPLIFY_FILE_NAME(__FILE__); } \
+        }
+
+#if META_TRACE_ENABLE
+    /**
+     * @brief Time the rest of the enclosing scope. At most one site per line.
+     */
+    #define META_TRACE_SCOPE(name) \
+        META_TRACE_SITE_TYPE(name); \
+        Meta::TraceScope<> META_TRACE_CONCAT(metaTraceScope, __LINE__)( \
+            Meta::TraceSite<META_TRACE_CONCAT(MetaTraceSite, __LINE__), Meta::TRACE_SCOPE>::point())
+
+    /**
+     * @brief Count how many times this line is reached.
+     */
+    #define META_COUNTER(name) META_COUNTER_ADD(name, 1)
+
+    /**
+     * @brief Add n to a counter.
+     */
+    #define META_COUNTER_ADD(name, n) do { \
+            META_TRACE_SITE_TYPE(name); \
+            Meta::TraceSite<META_TRACE_CONCAT(MetaTraceSite, __LINE__), Meta::TRACE_COUNTER>::point().count += (uint32_t)(n); \
+        } while (0)
+#else
+    #define META_TRACE_SCOPE(name) static_assert(true, "")
+    #define META_COUNTER(name) ((void)0)
+    #define META_COUNTER_ADD(name, n) ((void)0)
+#endif
+
+    /**
+     * @brief Write every trace site's statistics into the log as binary records.
+     */
+    #define META_TRACE_FLUSH() Meta::Traces::flush(META_LOGGER())
+
+    /**
+     * @brief Write the trace site table into the log.
+     */
+    #define META_TRACE_TABLE() Meta::Traces::exportTable(META_LOGGER())
+}
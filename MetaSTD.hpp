@@ -3,9 +3,32 @@
 #include "Errors/Errors.hpp"
 #include "Errors/ErrorUnion.hpp"
 
+#include "Logging/Timestamp.hpp"
 #include "Logging/ILogger.hpp"
+#include "Logging/AsyncLogger.hpp"
+#include "Logging/TeeLogger.hpp"
+#include "Logging/FlightRecorder.hpp"
+#include "Logging/TokenLogger.hpp"
+#include "Logging/Trace.hpp"
 
+#include "Utils/Endian.hpp"
+#include "Utils/Fields.hpp"
 #include "Utils/ArrayUtils.hpp"
+#include "Utils/Constexpr.hpp"
+#include "Utils/Crc.hpp"
 #include "Utils/AbstractLock.hpp"
+#include "Utils/Locks.hpp"
+#include "Utils/Hex.hpp"
+#include "Utils/Serializer.hpp"
+#include "Utils/Simd.hpp"
+#include "Utils/Format.hpp"
 
+#include "Structures/BufferView.hpp"
 #include "Structures/Buffer.hpp"
+#include "Structures/SoABuffer.hpp"
+#include "Structures/RingBuffer.hpp"
+#include "Structures/MpscQueue.hpp"
+#include "Structures/FrameParser.hpp"
+#include "Structures/Pool.hpp"
+#include "Structures/StaticMap.hpp"
+#include "Structures/StaticString.hpp"
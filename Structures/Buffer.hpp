@@ -1,15 +1,22 @@
 #pragma once
 
 #include <array>
+#include <algorithm>
 #include <initializer_list>
 #include <cstdint>
+#include <cstring>
+#include <type_traits>
 #include "../Errors/ErrorUnion.hpp"
 #include "../Errors/Errors.hpp"
 #include "../Logging/ILogger.hpp"
+#include "../Logging/Trace.hpp"
+#include "../Utils/ArrayUtils.hpp"
+#include "../Utils/Constexpr.hpp"
+#include "BufferView.hpp"
 
 namespace Meta {
 
-const ErrorDef BUFFER_ERROR_OVERRUN = REGISTER_ERROR("BUFFER_ERROR_OVERRUN");
+inline const ErrorDef& BUFFER_ERROR_OVERRUN = REGISTER_ERROR("BUFFER_ERROR_OVERRUN");
 
 /**
  * @brief A static structure that provides many of the conviences associated with std::vector, but without
@@ -17,26 +24,102 @@ const ErrorDef BUFFER_ERROR_OVERRUN = REGISTER_ERROR("BUFFER_ERROR_OVERRUN");
  *
  * @tparam T The underlying data type the buffer holds.
  * @tparam C The capacity of the buffer as a count of Tsj.
+ * @tparam Align The alignment of the storage, e.g. META_CACHE_LINE_SIZE for SIMD loads or a DMA controller's burst
+ *         alignment so transfers can go straight from (or into) the buffer.
  */
-template<typename T, size_t C>
+template<typename T, size_t C, size_t Align = alignof(T)>
 class Buffer {
+    static_assert(Align >= alignof(T) && (Align & (Align - 1)) == 0,
+                  "Buffer alignment must be a power of two no weaker than the element's.");
+
+    template<typename, size_t, size_t>
+    friend class Buffer;
+
 private:
-    std::array<T, C> data; // The underlying (static) array
+    alignas(Align) std::array<T, C> data; // The underlying (static) array
     size_t length; // How many Ts are currently stored in the buffer
 
+    struct Uninitialized {};
+
+    /**
+     * @brief Instantiate an empty buffer without touching its storage.
+     */
+    explicit META_CONSTEXPR20 Buffer(Uninitialized) : length(0) {
+        fillIfConstant();
+    }
+
+    /**
+     * @brief Constant evaluation cannot leave storage indeterminate, so there every element is given a value.
+     */
+    META_CONSTEXPR20 void fillIfConstant() {
+        if (isConstantEvaluated()) {
+            for (T& t : data) {
+                t = T();
+            }
+        }
+    }
+
+    /**
+     * @brief Copy n (possibly overlapping) Ts from src to dst. Trivially copyable Ts are moved as one bulk byte copy.
+     */
+    static META_CONSTEXPR20 void copyElements(T* dst, const T* src, size_t n) {
+        if (isConstantEvaluated()) {
+            // Pointers into different arrays cannot be ordered here, only compared for equality
+            bool backward = false;
+            for (size_t i = 1; i < n && !backward; i++) {
+                backward = src + i == dst;
+            }
+            if (backward) {
+                std::copy_backward(src, src + n, dst + n);
+            } else {
+                std::copy(src, src + n, dst);
+            }
+        } else if constexpr (std::is_trivially_copyable<T>::value) {
+            if (n) {
+                memmove(dst, src, n * sizeof(T));
+            }
+        } else if (dst <= src) {
+            std::copy(src, src + n, dst);
+        } else {
+            std::copy_backward(src, src + n, dst + n);
+        }
+    }
+
+    /**
+     * @brief Move n Ts from src to dst, another buffer's storage. Trivially copyable Ts are one bulk byte copy.
+     */
+    static META_CONSTEXPR20 void moveElements(T* dst, T* src, size_t n) {
+        if (isConstantEvaluated()) {
+            std::move(src, src + n, dst);
+        } else if constexpr (std::is_trivially_copyable<T>::value) {
+            if (n) {
+                memcpy(dst, src, n * sizeof(T));
+            }
+        } else {
+            std::move(src, src + n, dst);
+        }
+    }
+
 public:
     /**
      * @brief Instantiate an empty, zeroed out buffer.
      */
-    Buffer() : length(0) {
-        data.fill(T());
+    META_CONSTEXPR20 Buffer() : data(), length(0) {}
+
+    /**
+     * @brief Instantiate an empty buffer without zeroing its storage. Elements past size() are left
+     *         default-initialized, which for trivial Ts means they are never written until pushed or appended.
+     */
+    static META_CONSTEXPR20 Buffer uninitialized() {
+        return Buffer(Uninitialized{});
     }
 
     /**
      * @brief Wrap a buffer over a (copy of a) standard array.
      */
     template<size_t N>
-    Buffer(const std::array<T, N>& arr) : length(N) {
+    META_CONSTEXPR20 Buffer(const std::array<T, N>& arr) : length(N) {
+        fillIfConstant();
         static_assert(N <= C, "Instantiating array may not be larger than the buffer capacity.");
         std::copy(arr.begin(), arr.begin() + N, data.begin());
     }
@@ -44,61 +127,74 @@ public:
     /**
      * @brief Wrap a buffer around a (copy of a ) C-style array. 
      */
-    Buffer(const T* arr, size_t len) : length(len) {
-        std::copy(arr, arr + len, data.begin());
+    META_CONSTEXPR20 Buffer(const T* arr, size_t len) : length(len) {
+        fillIfConstant();
+        if (length > C) {
+            LOG_ERROR("Buffer overrun");
+            META_COUNTER("Buffer overrun");
+            length = C;
+        }
+        copyElements(data.data(), arr, length);
     }
 
     /**
      * @brief Instantiate a buffer from an initializer.
      */
-    Buffer(std::initializer_list<T> list) : length(list.size()) {
+    META_CONSTEXPR20 Buffer(std::initializer_list<T> list) : length(list.size()) {
+        fillIfConstant();
         std::copy(list.begin(), list.end(), data.begin());
     }
 
     // Copy
-    Buffer(const Buffer<T, C>& other) : length(other.length) {
-        std::copy(other.data.begin(), other.data.begin() + other.length, data.begin());
+    META_CONSTEXPR20 Buffer(const Buffer& other) : length(other.length) {
+        fillIfConstant();
+        copyElements(data.data(), other.data.data(), other.length);
     }
 
-    // Move
-    Buffer(Buffer<T, C>&& other) noexcept : data(move(other.data)), length(other.length) {
+    // Move, only the other buffer's size() Ts
+    META_CONSTEXPR20 Buffer(Buffer&& other) noexcept : length(other.length) {
+        fillIfConstant();
+        moveElements(data.data(), other.data.data(), other.length);
         other.length = 0;
     }
 
-    // Assignment
-    Buffer<T, C>& operator=(const Buffer<T, C>& other) {
-        data = other.data;
-        length = other.length;
+    // Assignment, only the other buffer's size() Ts
+    META_CONSTEXPR20 Buffer& operator=(const Buffer& other) {
+        if (this != &other) {
+            copyElements(data.data(), other.data.data(), other.length);
+            length = other.length;
+        }
         return *this;
     }
 
-    // Move assignment
-    Buffer<T, C>& operator=(Buffer<T, C>&& other) noexcept {
-        data = std::move(other.data);
-        length = other.length;
-        other.length = 0;
+    // Move assignment, only the other buffer's size() Ts
+    META_CONSTEXPR20 Buffer& operator=(Buffer&& other) noexcept {
+        if (this != &other) {
+            moveElements(data.data(), other.data.data(), other.length);
+            length = other.length;
+            other.length = 0;
+        }
         return *this;
     }
-    
 
     /**
      * @brief Reset a buffer to its default state.
      */
-    void clear() {
+    META_CONSTEXPR20 void clear() {
         length = 0;
     }
 
     /**
      * @brief Get a reference to the underlying array.
      */
-    const std::array<T, C>& getRaw() const {
+    META_CONSTEXPR20 const std::array<T, C>& getRaw() const {
         return data;
     }
 
     /**
      * @brief Get a raw (read-only) pointer to the buffer's data.
      */
-    const T* cArr() const {
+    META_CONSTEXPR20 const T* cArr() const {
         return data.data();
     }
 
@@ -107,50 +203,103 @@ public:
      *
      * @return An error if the buffer's capacity would be exceeded, void otherwise.
      */
-    ErrorUnion<void> push_back(T t) {
+    META_CONSTEXPR20 ErrorUnion<void> push_back(const T& t) {
         if (length >= C) {
             LOG_ERROR("Buffer overrun");
+            META_COUNTER("Buffer overrun");
             return ErrorUnion<void>(MAKE_ERROR(BUFFER_ERROR_OVERRUN, "Buffer overrun"));
         }
         data[length++] = t;
         return ErrorUnion<void>();
     }
 
+    META_CONSTEXPR20 ErrorUnion<void> push_back(T&& t) {
+        if (length >= C) {
+            LOG_ERROR("Buffer overrun");
+            META_COUNTER("Buffer overrun");
+            return ErrorUnion<void>(MAKE_ERROR(BUFFER_ERROR_OVERRUN, "Buffer overrun"));
+        }
+        data[length++] = std::move(t);
+        return ErrorUnion<void>();
+    }
+
+    /**
+     * @brief Construct a T in place at the back of the buffer, replacing the spare element stored there.
+     *
+     * @return An error if the buffer's capacity would be exceeded, void otherwise.
+     */
+    template<typename... Args>
+    META_CONSTEXPR20 ErrorUnion<void> emplace_back(Args&&... args) {
+        if (length >= C) {
+            LOG_ERROR("Buffer overrun");
+            META_COUNTER("Buffer overrun");
+            return ErrorUnion<void>(MAKE_ERROR(BUFFER_ERROR_OVERRUN, "Buffer overrun"));
+        }
+        T* const slot = data.data() + length++;
+        slot->~T();
+        constructAt(slot, std::forward<Args>(args)...);
+        return ErrorUnion<void>();
+    }
+
     /**
      * @brief Add a range of Ts represented as a C-style array.
      *
      * @return An error if the buffer's capacity would be exceeded, void otherwise.
      */
-    ErrorUnion<void> append(const T* arr, size_t len) {
+    META_CONSTEXPR20 ErrorUnion<void> append(const T* arr, size_t len) {
         if (length + len > C) {
             LOG_ERROR("Buffer overrun");
+            META_COUNTER("Buffer overrun");
             return ErrorUnion<void>(MAKE_ERROR(BUFFER_ERROR_OVERRUN, "Buffer overrun"));
         }
-        std::copy(arr, arr + len, data.begin() + length);
+        copyElements(data.data() + length, arr, len);
         length += len;
         return ErrorUnion<void>();
     }
 
     template<size_t N>
-    ErrorUnion<void> append(const std::array<T, N>& arr) {
+    META_CONSTEXPR20 ErrorUnion<void> append(const std::array<T, N>& arr) {
         static_assert(N <= C, "Buffer would overrun");
         return append(arr.data(), arr.size());
     }
 
+    /**
+     * @brief Add a range of T's depicted by a view.
+     */
+    META_CONSTEXPR20 ErrorUnion<void> append(const BufferView<T>& view) {
+        return append(view.cArr(), view.size());
+    }
+
     /**
      * @brief Add a range of T's depicted by another buffer.
      */
-    template<size_t N>
-    ErrorUnion<void> append(const Buffer<T, N>& other) {
+    template<size_t N, size_t A>
+    META_CONSTEXPR20 ErrorUnion<void> append(const Buffer<T, N, A>& other) {
         static_assert(N <= C, "Buffer overrun");
         return append(other.cArr(), other.size());
     }
 
     /**
-     * @brief Extract a T from the buffer's back.
+     * @brief Grow the buffer by n Ts that the caller fills in place, e.g. by encoding straight into it.
+     *
+     * @return Where the new Ts start, or an error if the buffer's capacity would be exceeded.
+     */
+    META_CONSTEXPR20 ErrorUnion<T*> extend(size_t n) {
+        if (n > C - length) {
+            LOG_ERROR("Buffer overrun");
+            META_COUNTER("Buffer overrun");
+            return ErrorUnion<T*>(MAKE_ERROR(BUFFER_ERROR_OVERRUN, "Buffer overrun"));
+        }
+        T* const tail = data.data() + length;
+        length += n;
+        return ErrorUnion<T*>(tail);
+    }
+
+    /**
+     * @brief Extract (move out) the T at the buffer's back. The buffer must not be empty.
      */
-    T pop_back() {
-        return data[length--];
+    META_CONSTEXPR20 T pop_back() {
+        return std::move(data[--length]);
     }
 
     /**
@@ -161,35 +310,44 @@ public:
      * @param count How many T's to copy.
      * @return An error if bounds or capacities are violated. Void otherwise.
      */
-    template<size_t N>
-    ErrorUnion<void> copy(const Buffer<T, N>& from, size_t offset = 0, size_t count = (size_t)-1) {
-        if (offset > from.size()) {
-            LOG_ERROR("Offset out of bounds: %d > %d", offset, from.size());
-            return ErrorUnion<void>(MAKE_ERROR(BUFFER_ERROR_OVERRUN, "Offset out of bounds"));
+    template<size_t N, size_t A>
+    META_CONSTEXPR20 ErrorUnion<void> copy(const Buffer<T, N, A>& from, size_t offset = 0, size_t count = (size_t)-1) {
+        return copy(from.view(), offset, count);
+    }
+
+    META_CONSTEXPR20 ErrorUnion<void> copy(const BufferView<T>& from, size_t offset = 0, size_t count = (size_t)-1) {
+        auto range = from.subView(offset, count);
+        if (range.hasError()) {
+            LOG_ERROR("Copy range out of bounds: offset %zu of %zu", offset, from.size());
+            return ErrorUnion<void>(range.getErrorSite());
         }
 
-        if (count == (size_t)-1) {
-            count = from.size() - offset;
+        const BufferView<T> source = range.getValue();
+        if (length + source.size() > C) {
+            LOG_ERROR("Buffer overrun");
+            META_COUNTER("Buffer overrun");
+            return ErrorUnion<void>(MAKE_ERROR(BUFFER_ERROR_OVERRUN, "Buffer overrun"));
         }
-        std::copy(from.begin() + offset, from.begin() + offset + count, data.begin() + length);
-        length += count;
+        copyElements(data.data() + length, source.begin(), source.size());
+        length += source.size();
         return ErrorUnion<void>();
     }
 
     /**
      * @brief Copy a range of T's over the existing buffer contents, possibly overlapping the current back and altering the size.
      */
-    template<size_t N>
-    ErrorUnion<void> copyOver(size_t over, Buffer<T, N>& from, size_t offset = 0, size_t count = (size_t) - 1) {
+    template<size_t N, size_t A>
+    META_CONSTEXPR20 ErrorUnion<void> copyOver(size_t over, Buffer<T, N, A>& from, size_t offset = 0, size_t count = (size_t) - 1) {
         if (over + count > C) {
             LOG_ERROR("Buffer overrun");
+            META_COUNTER("Buffer overrun");
             return ErrorUnion<void>(MAKE_ERROR(BUFFER_ERROR_OVERRUN, "Buffer overrun"));
         }
 
         if (count == (size_t)-1) {
             count = from.size() - offset;
         }
-        std::copy(from.begin() + offset, from.begin() + offset + count, data.begin() + over);
+        copyElements(data.data() + over, from.begin() + offset, count);
         // Update length, accounting for overlap with existing data
         if (over + count > length) {
             length += count - offset;
@@ -197,46 +355,157 @@ public:
         return ErrorUnion<void>();
     }
 
-    size_t size() const {
+    /**
+     * @brief Find the first T equal to value at or after from, a vector at a time for bytes and small integers.
+     *
+     * @return Its index, or an error if there is none.
+     */
+    ErrorUnion<size_t> find(const T& value, size_t from = 0) const {
+        return view().find(value, from);
+    }
+
+    /**
+     * @brief Find the first T equal to any of those in set at or after from.
+     *
+     * @return Its index, or an error if there is none.
+     */
+    ErrorUnion<size_t> find_any(const BufferView<T>& set, size_t from = 0) const {
+        return view().find_any(set, from);
+    }
+
+    /**
+     * @brief Whether other holds the same Ts as this buffer.
+     */
+    bool equals(const BufferView<T>& other) const {
+        return view().equals(other);
+    }
+
+    template<size_t N, size_t A>
+    bool equals(const Buffer<T, N, A>& other) const {
+        return view().equals(other.view());
+    }
+
+    /**
+     * @brief Overwrite every stored T with value, as a single memset for bytes.
+     */
+    META_CONSTEXPR20 void fill(const T& value) {
+        if constexpr (sizeof(T) == 1 && std::is_trivially_copyable<T>::value) {
+            if (!isConstantEvaluated()) {
+                uint8_t byte;
+                memcpy(&byte, &value, 1);
+                memset(data.data(), byte, length);
+                return;
+            }
+        }
+        std::fill_n(data.data(), length, value);
+    }
+
+    /**
+     * @brief Replace every stored T t with f(t), e.g. to apply a gain. A plain loop over the storage, which the
+     *         compiler vectorizes when f is inlineable arithmetic.
+     */
+    template<typename F>
+    META_CONSTEXPR20 void transform(F&& f) {
+        T* const arr = data.data();
+        for (size_t i = 0; i < length; i++) {
+            arr[i] = f(arr[i]);
+        }
+    }
+
+    META_CONSTEXPR20 size_t size() const {
         return length;
     }
 
-    T& operator[](size_t idx) {
+    META_CONSTEXPR20 T& operator[](size_t idx) {
         return data[idx];
     }
 
-    const T& operator[](size_t idx) const {
+    META_CONSTEXPR20 const T& operator[](size_t idx) const {
         return data[idx];
     }
 
-    const T* begin() const {
+    META_CONSTEXPR20 const T* begin() const {
         return data.begin();
     }
 
-    const T* end() const {
+    META_CONSTEXPR20 const T* end() const {
         return data.begin() + length;
     }  
 
     /**
      * @brief Convert this buffer's contents into a byte string.
+     *
+     * @tparam E The byte order each T is written in. When it matches the host (or T is a byte) this is a single bulk
+     *         copy; POD structs can only be written in native order.
      */
-    Buffer<uint8_t, C * sizeof(T)> toBytes() const {
-        Buffer<uint8_t, C * sizeof(T)> bytes;
-        for (size_t i = 0; i < length; i++) {
-            bytes.append(getBytes(data[i]));
-        }
+    template<Endian E = Endian::Little>
+    META_CONSTEXPR20 Buffer<uint8_t, C * sizeof(T)> toBytes() const {
+        auto bytes = Buffer<uint8_t, C * sizeof(T)>::uninitialized();
+        storeBytes<T, E>(data.data(), length, bytes.data.data());
+        bytes.length = length * sizeof(T);
         return bytes;
     }
 
+    /**
+     * @brief Rebuild a buffer from a byte string written by toBytes, as a single bulk copy or byte swap.
+     *
+     * @return An error if bytes holds more than C Ts or ends partway through one, the buffer otherwise.
+     */
+    template<Endian E = Endian::Little>
+    static META_CONSTEXPR20 ErrorUnion<Buffer> fromBytes(const BufferView<uint8_t>& bytes) {
+        if (bytes.size() > C * sizeof(T)) {
+            LOG_ERROR("Buffer overrun");
+            META_COUNTER("Buffer overrun");
+            return ErrorUnion<Buffer>(MAKE_ERROR(BUFFER_ERROR_OVERRUN, "Buffer overrun"));
+        }
+        if (bytes.size() % sizeof(T) != 0) {
+            return ErrorUnion<Buffer>(MAKE_ERROR(BUFFER_ERROR_OUT_OF_BOUNDS, "Partial element"));
+        }
+        auto buf = uninitialized();
+        loadBytes<T, E>(bytes.cArr(), bytes.size() / sizeof(T), buf.data.data());
+        buf.length = bytes.size() / sizeof(T);
+        return ErrorUnion<Buffer>(std::move(buf));
+    }
+
+    /**
+     * @brief Get a (zero-copy) view over this buffer's contents.
+     */
+    META_CONSTEXPR20 BufferView<T> view() const {
+        return BufferView<T>(data.data(), length);
+    }
+
+    /**
+     * @brief Get a (zero-copy) view over count T's starting at offset.
+     *
+     * @return An error if the range is not within the buffer's contents, the view otherwise.
+     */
+    META_CONSTEXPR20 ErrorUnion<BufferView<T>> view(size_t offset, size_t count = (size_t)-1) const {
+        return view().subView(offset, count);
+    }
+
+    /**
+     * @brief Get a (zero-copy) view over a statically defined subset of this buffer. The range is checked against the
+     *         capacity at compile time and clamped to the buffer's contents at runtime, so the view is shorter than
+     *         end - start when the buffer holds fewer Ts.
+     */
+    template<size_t start, size_t end>
+    META_CONSTEXPR20 BufferView<T> subView() const {
+        static_assert(start <= end && end <= C, "View must lie within the buffer capacity.");
+        const size_t last = end < length ? end : length;
+        return BufferView<T>(data.data() + start, start < last ? last - start : 0);
+    }
+
     /**
      * @brief Extract a statically defined subset of this buffer. 
      */
     template<size_t start, size_t end>
-    Buffer<uint8_t, end - start> subBuffer() const {
-        Buffer<uint8_t, end - start> sub;
+    META_CONSTEXPR20 Buffer<uint8_t, end - start> subBuffer() const {
+        static_assert(start <= end && end <= C, "Sub-buffer must lie within the buffer capacity.");
+        auto sub = Buffer<uint8_t, end - start>::uninitialized();
         for (size_t i = start; i < end; i++) {
-            sub.push_back(data[i]);
+            sub.data[i - start] = data[i];
         }
+        sub.length = end - start;
         return sub;
     }
 
@@ -244,10 +513,10 @@ public:
      * @brief Take(remove) n bytes from the front of this buffer.
      */
     template<size_t N>
-    Buffer<uint8_t, N> take(size_t n) {
+    META_CONSTEXPR20 Buffer<uint8_t, N> take(size_t n) {
         static_assert(N <= C, "Buffer overrun");
         // Extract the bytes to take
-        Buffer<uint8_t, N> taken;
+        auto taken = Buffer<uint8_t, N>::uninitialized();
         taken.copy(*this, 0, n);
 
         // Shift the remaining bytes left
@@ -258,31 +527,15 @@ public:
     }
 
     /**
-     * @brief Write the contents of this buffer to the local logging system in hexadecimal.
+     * @brief Write the contents of this buffer to the local logging system in hexadecimal, in memory order.
      */
     void hexDump(const char* msg = "",LogLevel level = LOG_LEVEL_DEBUG) const {
-        if (level < LOG_LEVEL)
+        if (!META_LOG_ENABLED(level) || level > LOG_LEVEL)
             return;
 
-        LOG(level, msg);
-        RAW_LOG("\r\n");
+        LOG(level, "%s", msg);
 
-        size_t bytesWritten = 0;
-        for (auto b : toBytes()) {
-            char hexStr[3];
-            snprintf(hexStr, sizeof(hexStr), "%02X", b);
-            RAW_LOG(hexStr);
-            RAW_LOG(" ");
-            bytesWritten++;
-
-            if (bytesWritten % 16 == 0) {
-                RAW_LOG("\n\r");
-            }
-            else if (bytesWritten % 8 == 0) {
-                RAW_LOG(" ");
-            }
-        }
-        RAW_LOG("\n\r");
+        META_LOGGER().writeHex(cArr(), length * sizeof(T));
     }
 };
 
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "../Errors/ErrorUnion.hpp"
+#include "../Errors/Errors.hpp"
+#include "../Utils/Simd.hpp"
+
+namespace Meta {
+
+inline const ErrorDef& BUFFER_ERROR_OUT_OF_BOUNDS = REGISTER_ERROR("BUFFER_ERROR_OUT_OF_BOUNDS");
+inline const ErrorDef& BUFFER_ERROR_NOT_FOUND = REGISTER_ERROR("BUFFER_ERROR_NOT_FOUND");
+
+/**
+ * @brief A non-owning, read-only window over a contiguous range of Ts.
+ *
+ * A view never copies the data it refers to, so it is only valid for as long as the underlying storage is.
+ *
+ * @tparam T The underlying data type the view refers to.
+ */
+template<typename T>
+class BufferView {
+private:
+    const T* ptr; // The first T in the view
+    size_t length; // How many Ts the view covers
+
+public:
+    /**
+     * @brief Instantiate an empty view.
+     */
+    constexpr BufferView() : ptr(nullptr), length(0) {}
+
+    /**
+     * @brief Wrap a view around a C-style array.
+     */
+    constexpr BufferView(const T* arr, size_t len) : ptr(arr), length(len) {}
+
+    /**
+     * @brief Wrap a view around a standard array.
+     */
+    template<size_t N>
+    constexpr BufferView(const std::array<T, N>& arr) : ptr(arr.data()), length(N) {}
+
+    constexpr size_t size() const {
+        return length;
+    }
+
+    constexpr bool empty() const {
+        return length == 0;
+    }
+
+    constexpr const T* cArr() const {
+        return ptr;
+    }
+
+    constexpr const T& operator[](size_t idx) const {
+        return ptr[idx];
+    }
+
+    constexpr const T* begin() const {
+        return ptr;
+    }
+
+    constexpr const T* end() const {
+        return ptr + length;
+    }
+
+    /**
+     * @brief Narrow the view to a statically defined subset, clamped to the view's size, so the result is shorter
+     *         than end - start when the view covers fewer Ts.
+     */
+    template<size_t start, size_t end>
+    constexpr BufferView<T> subView() const {
+        static_assert(start <= end, "View start may not be past its end.");
+        const size_t last = end < length ? end : length;
+        const size_t first = start < last ? start : last;
+        return BufferView<T>(ptr + first, last - first);
+    }
+
+    /**
+     * @brief Narrow the view to count Ts starting at offset.
+     *
+     * @return An error if the range is not covered by this view, the narrowed view otherwise.
+     */
+    META_CONSTEXPR20 ErrorUnion<BufferView<T>> subView(size_t offset, size_t count = (size_t)-1) const {
+        if (offset > length) {
+            return ErrorUnion<BufferView<T>>(MAKE_ERROR(BUFFER_ERROR_OUT_OF_BOUNDS, "Offset out of bounds"));
+        }
+        if (count == (size_t)-1) {
+            count = length - offset;
+        }
+        if (count > length - offset) {
+            return ErrorUnion<BufferView<T>>(MAKE_ERROR(BUFFER_ERROR_OUT_OF_BOUNDS, "Count out of bounds"));
+        }
+        return ErrorUnion<BufferView<T>>(BufferView<T>(ptr + offset, count));
+    }
+
+    /**
+     * @brief The first n Ts of the view, clamped to its size.
+     */
+    constexpr BufferView<T> first(size_t n) const {
+        return BufferView<T>(ptr, n < length ? n : length);
+    }
+
+    /**
+     * @brief Everything after the first n Ts of the view, clamped to its size.
+     */
+    constexpr BufferView<T> dropFirst(size_t n) const {
+        return n < length ? BufferView<T>(ptr + n, length - n) : BufferView<T>(ptr + length, 0);
+    }
+
+    /**
+     * @brief Find the first T equal to value at or after from. Bytes and 2/4 byte integers are compared a vector
+     *         (16 or 32 bytes) at a time.
+     *
+     * @return Its index, or an error if there is none.
+     */
+    ErrorUnion<size_t> find(const T& value, size_t from = 0) const {
+        if (from < length) {
+            const size_t at = from + Simd::find(ptr + from, length - from, value);
+            if (at < length) {
+                return ErrorUnion<size_t>(at);
+            }
+        }
+        return ErrorUnion<size_t>(MAKE_ERROR(BUFFER_ERROR_NOT_FOUND, "Not found"));
+    }
+
+    /**
+     * @brief Find the first T equal to any of those in set at or after from, e.g. any of several delimiters.
+     *
+     * @return Its index, or an error if there is none.
+     */
+    ErrorUnion<size_t> find_any(const BufferView<T>& set, size_t from = 0) const {
+        if (from < length) {
+            const size_t at = from + Simd::findAny(ptr + from, length - from, set.cArr(), set.size());
+            if (at < length) {
+                return ErrorUnion<size_t>(at);
+            }
+        }
+        return ErrorUnion<size_t>(MAKE_ERROR(BUFFER_ERROR_NOT_FOUND, "Not found"));
+    }
+
+    /**
+     * @brief Whether other covers the same number of equal Ts, compared a vector at a time where possible.
+     */
+    bool equals(const BufferView<T>& other) const {
+        return length == other.length && Simd::equal(ptr, other.ptr, length);
+    }
+};
+
+}
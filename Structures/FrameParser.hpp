@@ -0,0 +1,269 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include "../Errors/ErrorUnion.hpp"
+#include "../Errors/Errors.hpp"
+#include "../Utils/Endian.hpp"
+#include "../Utils/Simd.hpp"
+#include "BufferView.hpp"
+
+namespace Meta {
+
+inline const ErrorDef& FRAME_ERROR_INCOMPLETE = REGISTER_ERROR("FRAME_ERROR_INCOMPLETE");
+inline const ErrorDef& FRAME_ERROR_OVERSIZE = REGISTER_ERROR("FRAME_ERROR_OVERSIZE");
+inline const ErrorDef& FRAME_ERROR_MALFORMED = REGISTER_ERROR("FRAME_ERROR_MALFORMED");
+
+typedef enum {
+    FRAME_PENDING = 0, // No complete frame yet
+    FRAME_COMPLETE = 1,
+    FRAME_MALFORMED = 2, // The bytes up to the end of the frame cannot be decoded and are dropped
+    FRAME_OVERSIZE = 3, // The frame can never fit the parser, its header is dropped
+} FrameStatus;
+
+/**
+ * @brief Where a frame lies within the pending bytes of a FrameParser.
+ */
+typedef struct {
+    size_t offset; // Where the payload starts
+    size_t length; // How long the payload is
+    size_t consumed; // How many pending bytes the whole frame (header, payload, delimiter) took up
+} FrameSpan;
+
+/*
+ * Framing policies look for the first frame in a FrameParser's pending bytes:
+ *
+ *   FrameStatus find(uint8_t* pending, size_t len, size_t capacity, FrameSpan& span);
+ *   void reset();
+ *
+ * find() is called again with more bytes after returning FRAME_PENDING, and may keep state between those calls so
+ *  no byte is looked at twice. reset() is called once a frame has been consumed. Payloads may be decoded in place.
+ *  capacity is the most bytes a whole frame can take up: a policy that learns a frame is larger returns
+ *  FRAME_OVERSIZE at once rather than waiting for bytes that can never arrive.
+ */
+
+/**
+ * @brief Frames terminated by a single delimiter byte, e.g. newline terminated text. The delimiter is not part of
+ *         the payload.
+ */
+template<uint8_t Delimiter = '\n'>
+class DelimiterFraming {
+private:
+    size_t scanned; // How many pending bytes are known not to be the delimiter
+
+public:
+    constexpr DelimiterFraming() : scanned(0) {}
+
+    FrameStatus find(uint8_t* pending, size_t len, size_t capacity, FrameSpan& span) {
+        (void)capacity;
+        const size_t at = scanned + Simd::find<uint8_t>(pending + scanned, len - scanned, Delimiter);
+        if (at == len) {
+            scanned = len;
+            return FRAME_PENDING;
+        }
+        span = {0, at, at + 1};
+        return FRAME_COMPLETE;
+    }
+
+    void reset() {
+        scanned = 0;
+    }
+};
+
+/**
+ * @brief Frames led by their payload length.
+ *
+ * @tparam L The unsigned integral type of the length header.
+ * @tparam E The byte order of the length header.
+ */
+template<typename L = uint16_t, Endian E = Endian::Little>
+class LengthPrefixFraming {
+    static_assert(std::is_unsigned<L>::value, "The length header must be an unsigned integral type.");
+
+public:
+    constexpr LengthPrefixFraming() {}
+
+    FrameStatus find(uint8_t* pending, size_t len, size_t capacity, FrameSpan& span) {
+        if (len < sizeof(L)) {
+            return FRAME_PENDING;
+        }
+        L header;
+        memcpy(&header, pending, sizeof(L));
+        const size_t payload = (size_t)toEndian<E>(header);
+        if (payload > capacity - sizeof(L)) {
+            span = {0, 0, sizeof(L)};
+            return FRAME_OVERSIZE;
+        }
+        if (len - sizeof(L) < payload) {
+            return FRAME_PENDING;
+        }
+        span = {sizeof(L), payload, sizeof(L) + payload};
+        return FRAME_COMPLETE;
+    }
+
+    void reset() {}
+};
+
+/**
+ * @brief Consistent Overhead Byte Stuffing: frames are COBS encoded and terminated by a zero byte, so a receiver can
+ *         resynchronize at the next zero after any corruption. Payloads are decoded in place.
+ */
+class CobsFraming {
+private:
+    DelimiterFraming<0> delimiter;
+
+public:
+    constexpr CobsFraming() : delimiter() {}
+
+    FrameStatus find(uint8_t* pending, size_t len, size_t capacity, FrameSpan& span) {
+        FrameSpan encoded;
+        if (delimiter.find(pending, len, capacity, encoded) != FRAME_COMPLETE) {
+            return FRAME_PENDING;
+        }
+
+        // Decoded bytes never overtake encoded ones, so decoding can overwrite the frame as it goes
+        const size_t n = encoded.length;
+        size_t in = 0;
+        size_t out = 0;
+        while (in < n) {
+            const uint8_t code = pending[in++];
+            if (code - 1u > n - in) {
+                span = {0, 0, encoded.consumed};
+                return FRAME_MALFORMED;
+            }
+            for (uint8_t i = 1; i < code; i++) {
+                pending[out++] = pending[in++];
+            }
+            if (code != 0xFF && in < n) {
+                pending[out++] = 0;
+            }
+        }
+        span = {0, out, encoded.consumed};
+        return FRAME_COMPLETE;
+    }
+
+    void reset() {
+        delimiter.reset();
+    }
+};
+
+/**
+ * @brief Reassembles frames from a byte stream fed in arbitrary pieces, e.g. straight from a UART or socket read.
+ *
+ * Bytes are kept in linear storage and consumed from the front by advancing an offset, so taking k frames costs
+ *  nothing beyond scanning their bytes once. The unconsumed tail is only moved back to the start when a feed would
+ *  otherwise not fit. Frames come out as views into that storage. Nothing logs, so it is safe in interrupt context.
+ *
+ * @tparam C The capacity in bytes. Must hold the largest encoded frame.
+ * @tparam Policy The framing policy: DelimiterFraming, LengthPrefixFraming or CobsFraming.
+ */
+template<size_t C, typename Policy = DelimiterFraming<>>
+class FrameParser {
+    static_assert(C > 0, "FrameParser must hold at least one byte.");
+
+private:
+    std::array<uint8_t, C> data; // The underlying (static) storage
+    size_t start; // The first unconsumed byte
+    size_t end; // One past the last byte fed
+    Policy policy;
+
+    void compact() {
+        memmove(data.data(), data.data() + start, end - start);
+        end -= start;
+        start = 0;
+    }
+
+    void consume(size_t n) {
+        start += n;
+        policy.reset();
+        if (start == end) {
+            start = end = 0;
+        }
+    }
+
+public:
+    /**
+     * @brief Instantiate an empty parser.
+     */
+    FrameParser() : start(0), end(0), policy() {}
+
+    /**
+     * @brief Add received bytes. Invalidates views returned by next().
+     *
+     * @return How many bytes were accepted; fewer than len once the parser is full.
+     */
+    size_t feed(const uint8_t* bytes, size_t len) {
+        if (len > C - end && start > 0) {
+            compact();
+        }
+        const size_t n = len < C - end ? len : C - end;
+        memcpy(data.data() + end, bytes, n);
+        end += n;
+        return n;
+    }
+
+    size_t feed(const BufferView<uint8_t>& view) {
+        return feed(view.cArr(), view.size());
+    }
+
+    /**
+     * @brief Extract the next complete frame.
+     *
+     * If the parser fills up without completing a frame, its contents are dropped so parsing can resynchronize.
+     *
+     * @return The frame's payload, valid until the next feed(); FRAME_ERROR_INCOMPLETE if more bytes are needed;
+     *          FRAME_ERROR_MALFORMED or FRAME_ERROR_OVERSIZE if bytes had to be dropped.
+     */
+    ErrorUnion<BufferView<uint8_t>> next() {
+        FrameSpan span;
+        switch (policy.find(data.data() + start, end - start, C, span)) {
+            case FRAME_COMPLETE: {
+                const BufferView<uint8_t> frame(data.data() + start + span.offset, span.length);
+                consume(span.consumed);
+                return ErrorUnion<BufferView<uint8_t>>(frame);
+            }
+            case FRAME_MALFORMED:
+                consume(span.consumed);
+                return ErrorUnion<BufferView<uint8_t>>(MAKE_ERROR(FRAME_ERROR_MALFORMED, "Malformed frame"));
+            case FRAME_OVERSIZE:
+                consume(span.consumed);
+                return ErrorUnion<BufferView<uint8_t>>(MAKE_ERROR(FRAME_ERROR_OVERSIZE, "Frame exceeds parser capacity"));
+            case FRAME_PENDING:
+                break;
+        }
+
+        if (end - start == C) {
+            consume(C);
+            return ErrorUnion<BufferView<uint8_t>>(MAKE_ERROR(FRAME_ERROR_OVERSIZE, "Frame exceeds parser capacity"));
+        }
+        return ErrorUnion<BufferView<uint8_t>>(MAKE_ERROR(FRAME_ERROR_INCOMPLETE, "Frame incomplete"));
+    }
+
+    /**
+     * @brief Drop every pending byte.
+     */
+    void clear() {
+        start = end = 0;
+        policy.reset();
+    }
+
+    /**
+     * @brief How many bytes have been fed but not yet consumed as frames.
+     */
+    size_t pending() const {
+        return end - start;
+    }
+
+    size_t available() const {
+        return C - pending();
+    }
+
+    static constexpr size_t capacity() {
+        return C;
+    }
+};
+
+}
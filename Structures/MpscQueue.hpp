@@ -0,0 +1,129 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "../Errors/ErrorUnion.hpp"
+#include "../Errors/Errors.hpp"
+#include "../Utils/Constexpr.hpp"
+#include "RingBuffer.hpp"
+
+namespace Meta {
+
+/**
+ * @brief A fixed capacity, multi-producer/single-consumer queue (Dmitry Vyukov's bounded queue).
+ *
+ * Any number of contexts may push() concurrently; a single context pops. Each slot carries a sequence number, so
+ *  producers only contend on one compare-and-swap to claim a slot and never wait on each other or the consumer.
+ *  Records come out in the order their slots were claimed. A producer preempted between claiming and publishing its
+ *  slot holds back the consumer (pop() reports the queue as empty) until it resumes. Neither side logs.
+ *
+ * Drop-in for RingBuffer wherever only push(), pop() and the size queries are used.
+ *
+ * @tparam T The underlying data type the queue holds.
+ * @tparam C The capacity of the queue as a count of Ts. Must be a power of two.
+ */
+template<typename T, size_t C>
+class MpscQueue {
+    static_assert(C > 0 && (C & (C - 1)) == 0, "MpscQueue capacity must be a power of two.");
+
+private:
+    static constexpr size_t MASK = C - 1;
+
+    typedef struct {
+        std::atomic<size_t> sequence; // Equals the enqueue position once free, that position + 1 once published
+        T data;
+    } Cell;
+
+    std::array<Cell, C> cells; // The underlying (static) array
+    alignas(META_CACHE_LINE_SIZE) std::atomic<size_t> tail; // Next position to claim, shared by every producer
+    alignas(META_CACHE_LINE_SIZE) std::atomic<size_t> head; // Next position to read, only written by the consumer
+
+public:
+    /**
+     * @brief Instantiate an empty queue.
+     */
+    MpscQueue() : cells(), tail(0), head(0) {
+        for (size_t i = 0; i < C; i++) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscQueue(const MpscQueue<T, C>& other) = delete;
+    MpscQueue<T, C>& operator=(const MpscQueue<T, C>& other) = delete;
+
+    /**
+     * @brief Add a single T to the back of the queue. Safe from any number of producers.
+     *
+     * @return An error if the queue is full, void otherwise.
+     */
+    ErrorUnion<void> push(const T& t) {
+        size_t pos = tail.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &cells[pos & MASK];
+            const size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+            if (diff == 0) {
+                if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return ErrorUnion<void>(MAKE_ERROR(BUFFER_ERROR_OVERRUN, "Queue overrun"));
+            } else {
+                pos = tail.load(std::memory_order_relaxed);
+            }
+        }
+        cell->data = t;
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return ErrorUnion<void>();
+    }
+
+    /**
+     * @brief Extract a T from the front of the queue. Consumer side only.
+     *
+     * @return An error if the queue is empty (or its oldest slot is not yet published), the oldest T otherwise.
+     */
+    ErrorUnion<T> pop() {
+        const size_t pos = head.load(std::memory_order_relaxed);
+        Cell& cell = cells[pos & MASK];
+        if (cell.sequence.load(std::memory_order_acquire) != pos + 1) {
+            return ErrorUnion<T>(MAKE_ERROR(BUFFER_ERROR_UNDERRUN, "Queue underrun"));
+        }
+        ErrorUnion<T> t(cell.data);
+        cell.sequence.store(pos + C, std::memory_order_release);
+        head.store(pos + 1, std::memory_order_relaxed);
+        return t;
+    }
+
+    /**
+     * @brief Drop every published element currently in the queue. Consumer side only.
+     */
+    void clear() {
+        while (!pop().hasError()) {}
+    }
+
+    /**
+     * @brief How many slots are claimed or published. Only a snapshot while producers are active.
+     */
+    size_t size() const {
+        const size_t front = head.load(std::memory_order_acquire);
+        const size_t back = tail.load(std::memory_order_acquire);
+        return back - front > C ? C : back - front;
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    bool full() const {
+        return size() >= C;
+    }
+
+    static constexpr size_t capacity() {
+        return C;
+    }
+};
+
+}
@@ -0,0 +1,290 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include "../Errors/ErrorUnion.hpp"
+#include "../Errors/Errors.hpp"
+#include "../Logging/ILogger.hpp"
+#include "../Utils/Locks.hpp"
+
+namespace Meta {
+
+inline const ErrorDef& POOL_ERROR_OUT_OF_MEMORY = REGISTER_ERROR("POOL_ERROR_OUT_OF_MEMORY");
+inline const ErrorDef& POOL_ERROR_INVALID_FREE = REGISTER_ERROR("POOL_ERROR_INVALID_FREE");
+
+/**
+ * @brief A static pool of fixed-size slots for Ts, handed out and returned in O(1) through an intrusive free list.
+ *
+ * Objects still allocated when the pool is destroyed are not destructed.
+ *
+ * @tparam T The type of object the pool holds.
+ * @tparam N How many Ts the pool can hold at once.
+ * @tparam Lock Guards the free list when the pool is shared between threads. T's constructor and destructor run
+ *              outside it.
+ */
+template<typename T, size_t N, typename Lock = NullLock>
+class Pool {
+    static_assert(N > 0, "Pool must hold at least one object.");
+
+private:
+    union Slot {
+        Slot* next; // The next free slot, while this one is free
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    Slot slots[N]; // The underlying (static) storage
+    Slot* freeList; // The first free slot, null once exhausted
+    size_t used; // How many slots are currently allocated
+    mutable Lock mutex;
+
+public:
+    Pool() : freeList(slots), used(0) {
+        for (size_t i = 0; i < N; i++) {
+            slots[i].next = i + 1 < N ? &slots[i + 1] : nullptr;
+        }
+    }
+
+    Pool(const Pool<T, N, Lock>& other) = delete;
+    Pool<T, N, Lock>& operator=(const Pool<T, N, Lock>& other) = delete;
+
+    /**
+     * @brief Construct a T in a free slot.
+     *
+     * @return An error if every slot is in use, a pointer to the new T otherwise.
+     */
+    template<typename... Args>
+    ErrorUnion<T*> allocate(Args&&... args) {
+        Slot* slot;
+        {
+            LockGuard<Lock> guard(mutex);
+            slot = freeList;
+            if (slot != nullptr) {
+                freeList = slot->next;
+                used++;
+            }
+        }
+        if (slot == nullptr) {
+            LOG_ERROR("Pool exhausted");
+            return ErrorUnion<T*>(MAKE_ERROR(POOL_ERROR_OUT_OF_MEMORY, "Pool exhausted"));
+        }
+        return ErrorUnion<T*>(new (slot->storage) T(std::forward<Args>(args)...));
+    }
+
+    /**
+     * @brief Destruct a T and return its slot to the pool.
+     *
+     * @return An error if t did not come from this pool, void otherwise.
+     */
+    ErrorUnion<void> free(T* t) {
+        if (!owns(t)) {
+            LOG_ERROR("Freeing a pointer the pool does not own");
+            return ErrorUnion<void>(MAKE_ERROR(POOL_ERROR_INVALID_FREE, "Pointer not owned by pool"));
+        }
+        t->~T();
+        Slot* slot = reinterpret_cast<Slot*>(t);
+        LockGuard<Lock> guard(mutex);
+        slot->next = freeList;
+        freeList = slot;
+        used--;
+        return ErrorUnion<void>();
+    }
+
+    /**
+     * @brief Whether t points at one of this pool's slots.
+     */
+    bool owns(const T* t) const {
+        const unsigned char* p = reinterpret_cast<const unsigned char*>(t);
+        const unsigned char* first = reinterpret_cast<const unsigned char*>(slots);
+        return p >= first && p < first + sizeof(slots) && (size_t)(p - first) % sizeof(Slot) == 0;
+    }
+
+    size_t size() const {
+        LockGuard<Lock> guard(mutex);
+        return used;
+    }
+
+    size_t available() const {
+        return N - size();
+    }
+
+    static constexpr size_t capacity() {
+        return N;
+    }
+};
+
+/**
+ * @brief A Pool whose allocate and free may be called concurrently from any core or interrupt context.
+ *
+ * The free list is a Treiber stack of slot indices tagged against ABA, packed into a single 32 bit word so it stays
+ *  lock-free on cores without a double-word compare-and-swap. Neither side logs.
+ *
+ * @tparam T The type of object the pool holds.
+ * @tparam N How many Ts the pool can hold at once. At most 65535.
+ */
+template<typename T, size_t N>
+class LockFreePool {
+    static_assert(N > 0 && N < 0xFFFF, "LockFreePool must hold between 1 and 65534 objects.");
+
+private:
+    static constexpr uint32_t NONE = 0xFFFF; // Index marking the end of the free list
+
+    struct alignas(T) Slot {
+        unsigned char storage[sizeof(T)];
+    };
+
+    Slot slots[N]; // The underlying (static) storage
+    std::atomic<uint16_t> next[N]; // The next free slot of each free slot
+    std::atomic<uint32_t> head; // Tag in the upper half, index of the first free slot in the lower half
+    std::atomic<size_t> used; // How many slots are currently allocated
+
+    static constexpr uint32_t pack(uint32_t tag, uint32_t idx) {
+        return (tag << 16) | idx;
+    }
+
+public:
+    LockFreePool() : head(pack(0, 0)), used(0) {
+        for (size_t i = 0; i < N; i++) {
+            next[i].store(i + 1 < N ? (uint16_t)(i + 1) : (uint16_t)NONE, std::memory_order_relaxed);
+        }
+    }
+
+    LockFreePool(const LockFreePool<T, N>& other) = delete;
+    LockFreePool<T, N>& operator=(const LockFreePool<T, N>& other) = delete;
+
+    /**
+     * @brief Construct a T in a free slot.
+     *
+     * @return An error if every slot is in use, a pointer to the new T otherwise.
+     */
+    template<typename... Args>
+    ErrorUnion<T*> allocate(Args&&... args) {
+        uint32_t h = head.load(std::memory_order_acquire);
+        uint32_t idx;
+        do {
+            idx = h & 0xFFFF;
+            if (idx == NONE) {
+                return ErrorUnion<T*>(MAKE_ERROR(POOL_ERROR_OUT_OF_MEMORY, "Pool exhausted"));
+            }
+        } while (!head.compare_exchange_weak(h, pack((h >> 16) + 1, next[idx].load(std::memory_order_relaxed)),
+                                             std::memory_order_acquire, std::memory_order_acquire));
+        used.fetch_add(1, std::memory_order_relaxed);
+        return ErrorUnion<T*>(new (slots[idx].storage) T(std::forward<Args>(args)...));
+    }
+
+    /**
+     * @brief Destruct a T and return its slot to the pool.
+     *
+     * @return An error if t did not come from this pool, void otherwise.
+     */
+    ErrorUnion<void> free(T* t) {
+        if (!owns(t)) {
+            return ErrorUnion<void>(MAKE_ERROR(POOL_ERROR_INVALID_FREE, "Pointer not owned by pool"));
+        }
+        t->~T();
+        const uint32_t idx = (uint32_t)(reinterpret_cast<Slot*>(t) - slots);
+        uint32_t h = head.load(std::memory_order_relaxed);
+        do {
+            next[idx].store((uint16_t)(h & 0xFFFF), std::memory_order_relaxed);
+        } while (!head.compare_exchange_weak(h, pack((h >> 16) + 1, idx),
+                                             std::memory_order_release, std::memory_order_relaxed));
+        used.fetch_sub(1, std::memory_order_relaxed);
+        return ErrorUnion<void>();
+    }
+
+    /**
+     * @brief Whether t points at one of this pool's slots.
+     */
+    bool owns(const T* t) const {
+        const unsigned char* p = reinterpret_cast<const unsigned char*>(t);
+        const unsigned char* first = reinterpret_cast<const unsigned char*>(slots);
+        return p >= first && p < first + sizeof(slots) && (size_t)(p - first) % sizeof(Slot) == 0;
+    }
+
+    size_t size() const {
+        return used.load(std::memory_order_relaxed);
+    }
+
+    size_t available() const {
+        return N - size();
+    }
+
+    static constexpr size_t capacity() {
+        return N;
+    }
+};
+
+/**
+ * @brief A static bump allocator. Allocations are O(1) and are only released all at once by reset().
+ *
+ * reset() does not run destructors, so it is meant for trivially destructible objects or ones the caller destructs.
+ *
+ * @tparam Bytes The size of the arena's storage.
+ */
+template<size_t Bytes>
+class Arena {
+private:
+    alignas(std::max_align_t) unsigned char storage[Bytes]; // The underlying (static) storage
+    size_t offset; // The first unallocated byte
+
+public:
+    Arena() : offset(0) {}
+
+    Arena(const Arena<Bytes>& other) = delete;
+    Arena<Bytes>& operator=(const Arena<Bytes>& other) = delete;
+
+    /**
+     * @brief Reserve size bytes aligned to align (a power of two).
+     *
+     * @return An error if the arena does not have enough space left, a pointer to the bytes otherwise.
+     */
+    ErrorUnion<void*> allocate(size_t size, size_t align = alignof(std::max_align_t)) {
+        // Align the address rather than the offset, since storage itself is only aligned to max_align_t
+        const uintptr_t base = reinterpret_cast<uintptr_t>(storage);
+        const size_t padding = (size_t)(0 - (base + offset)) & (align - 1);
+        if (padding > Bytes - offset || size > Bytes - offset - padding) {
+            LOG_ERROR("Arena exhausted");
+            return ErrorUnion<void*>(MAKE_ERROR(POOL_ERROR_OUT_OF_MEMORY, "Arena exhausted"));
+        }
+        const size_t start = offset + padding;
+        offset = start + size;
+        return ErrorUnion<void*>(static_cast<void*>(storage + start));
+    }
+
+    /**
+     * @brief Construct a T in the arena.
+     *
+     * @return An error if the arena does not have enough space left, a pointer to the new T otherwise.
+     */
+    template<typename T, typename... Args>
+    ErrorUnion<T*> create(Args&&... args) {
+        auto mem = allocate(sizeof(T), alignof(T));
+        if (mem.hasError()) {
+            return ErrorUnion<T*>(mem.getErrorSite());
+        }
+        return ErrorUnion<T*>(new (mem.getValue()) T(std::forward<Args>(args)...));
+    }
+
+    /**
+     * @brief Release every allocation at once.
+     */
+    void reset() {
+        offset = 0;
+    }
+
+    size_t size() const {
+        return offset;
+    }
+
+    size_t available() const {
+        return Bytes - offset;
+    }
+
+    static constexpr size_t capacity() {
+        return Bytes;
+    }
+};
+
+}
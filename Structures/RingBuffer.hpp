@@ -0,0 +1,159 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "../Errors/ErrorUnion.hpp"
+#include "../Errors/Errors.hpp"
+#include "Buffer.hpp"
+
+namespace Meta {
+
+inline const ErrorDef& BUFFER_ERROR_UNDERRUN = REGISTER_ERROR("BUFFER_ERROR_UNDERRUN");
+
+/**
+ * @brief A fixed capacity, single-producer/single-consumer ring buffer.
+ *
+ * push() and pop() are wait-free as long as exactly one context produces and exactly one context consumes
+ *  (e.g. an ISR feeding a task). Neither side logs, so both are safe to call from interrupt context.
+ *
+ * @tparam T The underlying data type the ring holds.
+ * @tparam C The capacity of the ring as a count of Ts. Must be a power of two.
+ */
+template<typename T, size_t C>
+class RingBuffer {
+    static_assert(C > 0 && (C & (C - 1)) == 0, "RingBuffer capacity must be a power of two.");
+
+private:
+    static constexpr size_t MASK = C - 1;
+
+    std::array<T, C> data; // The underlying (static) array
+    std::atomic<size_t> head; // Next slot to read, only written by the consumer
+    std::atomic<size_t> tail; // Next slot to write, only written by the producer
+
+public:
+    /**
+     * @brief Instantiate an empty ring.
+     */
+    RingBuffer() : data(), head(0), tail(0) {}
+
+    RingBuffer(const RingBuffer<T, C>& other) = delete;
+    RingBuffer<T, C>& operator=(const RingBuffer<T, C>& other) = delete;
+
+    /**
+     * @brief Add a single T to the back of the ring. Producer side only.
+     *
+     * @return An error if the ring is full, void otherwise.
+     */
+    ErrorUnion<void> push(const T& t) {
+        const size_t back = tail.load(std::memory_order_relaxed);
+        if (back - head.load(std::memory_order_acquire) >= C) {
+            return ErrorUnion<void>(MAKE_ERROR(BUFFER_ERROR_OVERRUN, "Ring buffer overrun"));
+        }
+        data[back & MASK] = t;
+        tail.store(back + 1, std::memory_order_release);
+        return ErrorUnion<void>();
+    }
+
+    /**
+     * @brief Add a range of Ts represented as a C-style array. Nothing is written unless the whole range fits.
+     *
+     * @return An error if the ring's free space would be exceeded, void otherwise.
+     */
+    ErrorUnion<void> append(const T* arr, size_t len) {
+        const size_t back = tail.load(std::memory_order_relaxed);
+        if (back - head.load(std::memory_order_acquire) + len > C) {
+            return ErrorUnion<void>(MAKE_ERROR(BUFFER_ERROR_OVERRUN, "Ring buffer overrun"));
+        }
+        for (size_t i = 0; i < len; i++) {
+            data[(back + i) & MASK] = arr[i];
+        }
+        tail.store(back + len, std::memory_order_release);
+        return ErrorUnion<void>();
+    }
+
+    /**
+     * @brief Extract a T from the front of the ring. Consumer side only.
+     *
+     * @return An error if the ring is empty, the oldest T otherwise.
+     */
+    ErrorUnion<T> pop() {
+        const size_t front = head.load(std::memory_order_relaxed);
+        if (front == tail.load(std::memory_order_acquire)) {
+            return ErrorUnion<T>(MAKE_ERROR(BUFFER_ERROR_UNDERRUN, "Ring buffer underrun"));
+        }
+        ErrorUnion<T> t(data[front & MASK]);
+        head.store(front + 1, std::memory_order_release);
+        return t;
+    }
+
+    /**
+     * @brief Move up to N Ts from the front of the ring into a (cleared) Buffer. Consumer side only.
+     *
+     * @return How many Ts were taken.
+     */
+    template<size_t N, size_t A>
+    size_t take(Buffer<T, N, A>& out, size_t n = N) {
+        const size_t front = head.load(std::memory_order_relaxed);
+        const size_t available = tail.load(std::memory_order_acquire) - front;
+        if (n > available) {
+            n = available;
+        }
+        if (n > N) {
+            n = N;
+        }
+
+        out.clear();
+        // The readable region is at most two contiguous spans of the underlying array
+        const size_t first = (front & MASK) + n > C ? C - (front & MASK) : n;
+        out.append(data.data() + (front & MASK), first);
+        out.append(data.data(), n - first);
+
+        head.store(front + n, std::memory_order_release);
+        return n;
+    }
+
+    /**
+     * @brief Drop up to n Ts from the front of the ring without reading them. Consumer side only.
+     *
+     * @return How many Ts were dropped.
+     */
+    size_t skip(size_t n) {
+        const size_t front = head.load(std::memory_order_relaxed);
+        const size_t available = tail.load(std::memory_order_acquire) - front;
+        if (n > available) {
+            n = available;
+        }
+        head.store(front + n, std::memory_order_release);
+        return n;
+    }
+
+    /**
+     * @brief Drop every element currently in the ring. Consumer side only.
+     */
+    void clear() {
+        head.store(tail.load(std::memory_order_acquire), std::memory_order_release);
+    }
+
+    size_t size() const {
+        // Read head first so a concurrent pop can never make the difference negative
+        const size_t front = head.load(std::memory_order_acquire);
+        const size_t n = tail.load(std::memory_order_acquire) - front;
+        return n > C ? C : n;
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    bool full() const {
+        return size() >= C;
+    }
+
+    static constexpr size_t capacity() {
+        return C;
+    }
+};
+
+}
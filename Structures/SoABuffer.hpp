@@ -0,0 +1,203 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "../Errors/ErrorUnion.hpp"
+#include "../Errors/Errors.hpp"
+#include "../Logging/ILogger.hpp"
+#include "../Logging/Trace.hpp"
+#include "../Utils/Constexpr.hpp"
+#include "../Utils/Fields.hpp"
+#include "Buffer.hpp"
+#include "BufferView.hpp"
+
+namespace Meta {
+
+namespace Detail {
+template<typename T, size_t C>
+struct alignas(META_CACHE_LINE_SIZE) SoAColumn {
+    std::array<T, C> data;
+};
+}
+
+/**
+ * @brief A Buffer of structs stored as one cache line aligned array per field (a structure of arrays), with the
+ *         same push_back/append/size interface.
+ *
+ * A loop over a single field through column() then streams only that field's bytes and vectorizes like a loop over
+ *  a plain array, where a Buffer of the structs would drag every other field through the cache with it.
+ *
+ * @tparam C The capacity of the buffer as a count of structs.
+ * @tparam First, Rest The stored fields of one struct, as member pointers, e.g. SoABuffer<4096, &Sample::i,
+ *         &Sample::q>. Members left out are not stored, and structs read back get them value initialized.
+ */
+template<size_t C, auto First, auto... Rest>
+class SoABuffer {
+public:
+    typedef typename Detail::MemberPointer<decltype(First)>::Struct Struct;
+
+private:
+    template<auto Member>
+    using FieldType = typename Detail::MemberPointer<decltype(Member)>::Type;
+
+    static_assert((std::is_base_of<typename Detail::MemberPointer<decltype(Rest)>::Struct, Struct>::value && ...),
+                  "Every field of a SoABuffer must be a member of the same struct.");
+    static_assert(std::is_copy_assignable<FieldType<First>>::value && (std::is_copy_assignable<FieldType<Rest>>::value && ...),
+                  "SoABuffer fields must be copy assignable.");
+
+    static constexpr size_t FIELDS = 1 + sizeof...(Rest);
+    static constexpr std::tuple<decltype(First), decltype(Rest)...> MEMBERS{First, Rest...};
+
+    std::tuple<Detail::SoAColumn<FieldType<First>, C>, Detail::SoAColumn<FieldType<Rest>, C>...> columns;
+    size_t length; // How many structs are currently stored in the buffer
+
+    struct Uninitialized {};
+
+    explicit SoABuffer(Uninitialized) : length(0) {}
+
+    template<size_t I>
+    void scatterField(const Struct* src, size_t n) {
+        auto* dst = std::get<I>(columns).data.data() + length;
+        for (size_t k = 0; k < n; k++) {
+            dst[k] = src[k].*std::get<I>(MEMBERS);
+        }
+    }
+
+    template<size_t... I>
+    void scatter(const Struct* src, size_t n, std::index_sequence<I...>) {
+        (scatterField<I>(src, n), ...);
+    }
+
+    template<size_t... I>
+    void set(size_t idx, const Struct& s, std::index_sequence<I...>) {
+        ((std::get<I>(columns).data[idx] = s.*std::get<I>(MEMBERS)), ...);
+    }
+
+    template<size_t... I>
+    Struct get(size_t idx, std::index_sequence<I...>) const {
+        Struct s{};
+        ((s.*std::get<I>(MEMBERS) = std::get<I>(columns).data[idx]), ...);
+        return s;
+    }
+
+public:
+    /**
+     * @brief Instantiate an empty, zeroed out buffer.
+     */
+    SoABuffer() : columns(), length(0) {}
+
+    /**
+     * @brief Instantiate an empty buffer without zeroing its storage, like Buffer::uninitialized().
+     */
+    static SoABuffer uninitialized() {
+        return SoABuffer(Uninitialized{});
+    }
+
+    /**
+     * @brief Add a single struct to the back of the buffer, one field into each column.
+     *
+     * @return An error if the buffer's capacity would be exceeded, void otherwise.
+     */
+    ErrorUnion<void> push_back(const Struct& s) {
+        if (length >= C) {
+            LOG_ERROR("Buffer overrun");
+            META_COUNTER("Buffer overrun");
+            return ErrorUnion<void>(MAKE_ERROR(BUFFER_ERROR_OVERRUN, "Buffer overrun"));
+        }
+        set(length++, s, std::make_index_sequence<FIELDS>());
+        return ErrorUnion<void>();
+    }
+
+    /**
+     * @brief Add a range of structs represented as a C-style array, column by column.
+     *
+     * @return An error if the buffer's capacity would be exceeded, void otherwise.
+     */
+    ErrorUnion<void> append(const Struct* arr, size_t len) {
+        if (len > C - length) {
+            LOG_ERROR("Buffer overrun");
+            META_COUNTER("Buffer overrun");
+            return ErrorUnion<void>(MAKE_ERROR(BUFFER_ERROR_OVERRUN, "Buffer overrun"));
+        }
+        scatter(arr, len, std::make_index_sequence<FIELDS>());
+        length += len;
+        return ErrorUnion<void>();
+    }
+
+    ErrorUnion<void> append(const BufferView<Struct>& view) {
+        return append(view.cArr(), view.size());
+    }
+
+    template<size_t N, size_t A>
+    ErrorUnion<void> append(const Buffer<Struct, N, A>& other) {
+        return append(other.cArr(), other.size());
+    }
+
+    /**
+     * @brief Gather the struct at the buffer's back and remove it. The buffer must not be empty.
+     */
+    Struct pop_back() {
+        return get(--length, std::make_index_sequence<FIELDS>());
+    }
+
+    /**
+     * @brief Gather the struct at idx from every column.
+     */
+    Struct get(size_t idx) const {
+        return get(idx, std::make_index_sequence<FIELDS>());
+    }
+
+    /**
+     * @brief Overwrite the struct at idx, which must be below size().
+     */
+    void set(size_t idx, const Struct& s) {
+        set(idx, s, std::make_index_sequence<FIELDS>());
+    }
+
+    /**
+     * @brief The column holding one field for every stored struct, aligned to META_CACHE_LINE_SIZE. Valid for
+     *         size() elements.
+     */
+    template<auto Member>
+    FieldType<Member>* column() {
+        constexpr size_t index = Detail::memberIndex<Member, First, Rest...>();
+        static_assert(index < FIELDS, "The field is not stored in this SoABuffer.");
+        return std::get<index>(columns).data.data();
+    }
+
+    template<auto Member>
+    const FieldType<Member>* column() const {
+        constexpr size_t index = Detail::memberIndex<Member, First, Rest...>();
+        static_assert(index < FIELDS, "The field is not stored in this SoABuffer.");
+        return std::get<index>(columns).data.data();
+    }
+
+    /**
+     * @brief Get a (zero-copy) view over one field of every stored struct.
+     */
+    template<auto Member>
+    BufferView<FieldType<Member>> view() const {
+        return BufferView<FieldType<Member>>(column<Member>(), length);
+    }
+
+    /**
+     * @brief Reset a buffer to its default state.
+     */
+    void clear() {
+        length = 0;
+    }
+
+    size_t size() const {
+        return length;
+    }
+
+    static constexpr size_t capacity() {
+        return C;
+    }
+};
+
+}
@@ -0,0 +1,311 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include "../Errors/ErrorUnion.hpp"
+#include "../Errors/Errors.hpp"
+
+namespace Meta {
+
+inline const ErrorDef& MAP_ERROR_FULL = REGISTER_ERROR("MAP_ERROR_FULL");
+inline const ErrorDef& MAP_ERROR_NOT_FOUND = REGISTER_ERROR("MAP_ERROR_NOT_FOUND");
+
+/**
+ * @brief A seedable, constexpr hash for map keys. Integral and enum keys are mixed with the splitmix64 finalizer,
+ *         string views with FNV-1a.
+ */
+template<typename K, typename Enable = void>
+struct Hash;
+
+template<typename K>
+struct Hash<K, typename std::enable_if<std::is_integral<K>::value || std::is_enum<K>::value>::type> {
+    constexpr uint64_t operator()(const K& k, uint64_t seed = 0) const {
+        uint64_t x = (uint64_t)k ^ (seed * 0x9E3779B97F4A7C15ull);
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+};
+
+template<>
+struct Hash<std::string_view> {
+    constexpr uint64_t operator()(const std::string_view& k, uint64_t seed = 0) const {
+        uint64_t x = 0xCBF29CE484222325ull ^ seed;
+        for (char c : k) {
+            x = (x ^ (uint8_t)c) * 0x100000001B3ull;
+        }
+        return x;
+    }
+};
+
+/**
+ * @brief The smallest power of two that is at least n.
+ */
+static constexpr size_t nextPowerOfTwo(size_t n) {
+    size_t p = 1;
+    while (p < n) {
+        p <<= 1;
+    }
+    return p;
+}
+
+/**
+ * @brief A fixed capacity hash map over contiguous static storage, using open addressing with linear probing.
+ *
+ * Erase shifts the following entries of a probe run back, so there are no tombstones and lookups never degrade.
+ *
+ * @tparam K The key type.
+ * @tparam V The value type.
+ * @tparam C The capacity of the map as a count of entries. Must be a power of two.
+ */
+template<typename K, typename V, size_t C, typename H = Hash<K>>
+class StaticMap {
+    static_assert(C > 0 && (C & (C - 1)) == 0, "StaticMap capacity must be a power of two.");
+
+private:
+    static constexpr size_t MASK = C - 1;
+
+    typedef struct {
+        K key;
+        V value;
+        bool used;
+    } Slot;
+
+    std::array<Slot, C> slots; // The underlying (static) array
+    size_t length; // How many entries are currently stored
+
+    size_t home(const K& k) const {
+        return (size_t)H()(k) & MASK;
+    }
+
+    /**
+     * @return The slot holding k, or C if k is not in the map.
+     */
+    size_t locate(const K& k) const {
+        for (size_t i = home(k), probes = 0; probes < C && slots[i].used; i = (i + 1) & MASK, probes++) {
+            if (slots[i].key == k) {
+                return i;
+            }
+        }
+        return C;
+    }
+
+public:
+    /**
+     * @brief Instantiate an empty map.
+     */
+    StaticMap() : slots(), length(0) {}
+
+    /**
+     * @brief Insert k with value v, replacing the value if k is already present.
+     *
+     * @return An error if the map is full, void otherwise.
+     */
+    ErrorUnion<void> insert(const K& k, const V& v) {
+        size_t i = home(k);
+        for (size_t probes = 0; probes < C; i = (i + 1) & MASK, probes++) {
+            if (!slots[i].used) {
+                slots[i].key = k;
+                slots[i].value = v;
+                slots[i].used = true;
+                length++;
+                return ErrorUnion<void>();
+            }
+            if (slots[i].key == k) {
+                slots[i].value = v;
+                return ErrorUnion<void>();
+            }
+        }
+        return ErrorUnion<void>(MAKE_ERROR(MAP_ERROR_FULL, "Map full"));
+    }
+
+    /**
+     * @brief Look up the value stored under k.
+     *
+     * @return An error if k is not in the map, a pointer to its value otherwise.
+     */
+    ErrorUnion<V*> find(const K& k) {
+        const size_t i = locate(k);
+        if (i == C) {
+            return ErrorUnion<V*>(MAKE_ERROR(MAP_ERROR_NOT_FOUND, "Key not found"));
+        }
+        return ErrorUnion<V*>(&slots[i].value);
+    }
+
+    ErrorUnion<const V*> find(const K& k) const {
+        const size_t i = locate(k);
+        if (i == C) {
+            return ErrorUnion<const V*>(MAKE_ERROR(MAP_ERROR_NOT_FOUND, "Key not found"));
+        }
+        return ErrorUnion<const V*>(&slots[i].value);
+    }
+
+    bool contains(const K& k) const {
+        return locate(k) != C;
+    }
+
+    /**
+     * @brief Remove k from the map.
+     *
+     * @return An error if k is not in the map, void otherwise.
+     */
+    ErrorUnion<void> erase(const K& k) {
+        size_t hole = locate(k);
+        if (hole == C) {
+            return ErrorUnion<void>(MAKE_ERROR(MAP_ERROR_NOT_FOUND, "Key not found"));
+        }
+
+        // Shift later members of the probe run back into the hole so no lookup ever stops short
+        for (size_t i = (hole + 1) & MASK, probes = 1; probes < C && slots[i].used; i = (i + 1) & MASK, probes++) {
+            const size_t h = home(slots[i].key);
+            if (((i - h) & MASK) >= ((i - hole) & MASK)) {
+                slots[hole] = slots[i];
+                hole = i;
+            }
+        }
+        slots[hole].used = false;
+        length--;
+        return ErrorUnion<void>();
+    }
+
+    /**
+     * @brief Reset a map to its default state.
+     */
+    void clear() {
+        for (auto& slot : slots) {
+            slot.used = false;
+        }
+        length = 0;
+    }
+
+    size_t size() const {
+        return length;
+    }
+
+    static constexpr size_t capacity() {
+        return C;
+    }
+};
+
+/**
+ * @brief An immutable map built at compile time with a perfect hash (hash and displace): every key sits in its own
+ *         slot, so a lookup is two hashes and one comparison with no probing.
+ *
+ * @tparam K The key type.
+ * @tparam V The value type.
+ * @tparam N How many entries the map holds.
+ */
+template<typename K, typename V, size_t N, typename H = Hash<K>>
+class PerfectMap {
+    static_assert(N > 0, "PerfectMap must hold at least one entry.");
+
+private:
+    static constexpr size_t B = nextPowerOfTwo(N); // Bucket count
+    static constexpr size_t M = 2 * B; // Slot count
+
+    std::array<uint32_t, B> displacement; // Per-bucket hash seed
+    std::array<K, M> keys;
+    std::array<V, M> values;
+    std::array<bool, M> used;
+
+    static constexpr size_t bucket(const K& k) {
+        return (size_t)H()(k, 0) & (B - 1);
+    }
+
+    static constexpr size_t slot(const K& k, uint32_t d) {
+        return (size_t)H()(k, d) & (M - 1);
+    }
+
+public:
+    /**
+     * @brief Build the table. Keys must be unique.
+     */
+    constexpr PerfectMap(const std::array<std::pair<K, V>, N>& entries)
+        : displacement(), keys(), values(), used() {
+        std::array<size_t, B> sizes = {};
+        std::array<size_t, B> order = {};
+        for (size_t i = 0; i < N; i++) {
+            sizes[bucket(entries[i].first)]++;
+        }
+
+        // Place the largest buckets first, while the table is still empty
+        for (size_t i = 0; i < B; i++) {
+            order[i] = i;
+        }
+        for (size_t i = 1; i < B; i++) {
+            for (size_t j = i; j > 0 && sizes[order[j - 1]] < sizes[order[j]]; j--) {
+                const size_t tmp = order[j];
+                order[j] = order[j - 1];
+                order[j - 1] = tmp;
+            }
+        }
+
+        for (size_t o = 0; o < B && sizes[order[o]] > 0; o++) {
+            const size_t b = order[o];
+            for (uint32_t d = 1;; d++) {
+                // Try to give every key of the bucket its own free slot under seed d
+                std::array<bool, M> claimed = used;
+                bool fits = true;
+                for (size_t i = 0; i < N && fits; i++) {
+                    if (bucket(entries[i].first) != b) {
+                        continue;
+                    }
+                    const size_t s = slot(entries[i].first, d);
+                    fits = !claimed[s];
+                    claimed[s] = true;
+                }
+                if (!fits) {
+                    continue;
+                }
+
+                displacement[b] = d;
+                for (size_t i = 0; i < N; i++) {
+                    if (bucket(entries[i].first) == b) {
+                        const size_t s = slot(entries[i].first, d);
+                        keys[s] = entries[i].first;
+                        values[s] = entries[i].second;
+                        used[s] = true;
+                    }
+                }
+                break;
+            }
+        }
+    }
+
+    /**
+     * @brief Look up the value stored under k.
+     *
+     * @return A pointer to k's value, or null if k is not in the map.
+     */
+    constexpr const V* find(const K& k) const {
+        const size_t s = slot(k, displacement[bucket(k)]);
+        return used[s] && keys[s] == k ? &values[s] : nullptr;
+    }
+
+    constexpr bool contains(const K& k) const {
+        return find(k) != nullptr;
+    }
+
+    static constexpr size_t size() {
+        return N;
+    }
+};
+
+/**
+ * @brief Build a PerfectMap from a list of key/value pairs, e.g. at compile time into a constexpr table.
+ */
+template<typename K, typename V, size_t N, size_t... I>
+constexpr PerfectMap<K, V, N> makePerfectMap(const std::pair<K, V> (&entries)[N], std::index_sequence<I...>) {
+    return PerfectMap<K, V, N>(std::array<std::pair<K, V>, N>{entries[I]...});
+}
+
+template<typename K, typename V, size_t N>
+constexpr PerfectMap<K, V, N> makePerfectMap(const std::pair<K, V> (&entries)[N]) {
+    return makePerfectMap(entries, std::make_index_sequence<N>{});
+}
+
+}
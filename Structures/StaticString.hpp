@@ -0,0 +1,184 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "../Errors/ErrorUnion.hpp"
+#include "../Errors/Errors.hpp"
+#include "../Utils/Format.hpp"
+#include "BufferView.hpp"
+
+namespace Meta {
+
+inline const ErrorDef& STRING_ERROR_TRUNCATED = REGISTER_ERROR("STRING_ERROR_TRUNCATED");
+
+/**
+ * @brief A null terminated string with a fixed capacity and no heap allocation.
+ *
+ * Appends that do not fit are truncated to what does and report it, so the string always holds a valid prefix.
+ *  Nothing logs, so strings can be used to assemble log lines themselves.
+ *
+ * @tparam C The capacity in characters, not counting the terminator.
+ */
+template<size_t C>
+class StaticString {
+private:
+    char data[C + 1];
+    size_t length; // How many characters are currently stored, data[length] is always '\0'
+
+    ErrorUnion<void> truncatedBy(size_t wanted) {
+        if (wanted > C - length) {
+            length = C;
+            data[length] = '\0';
+            return ErrorUnion<void>(MAKE_ERROR(STRING_ERROR_TRUNCATED, "String truncated"));
+        }
+        length += wanted;
+        data[length] = '\0';
+        return ErrorUnion<void>();
+    }
+
+public:
+    /**
+     * @brief Instantiate an empty string.
+     */
+    StaticString() : length(0) {
+        data[0] = '\0';
+    }
+
+    /**
+     * @brief Instantiate a string holding (as much as fits of) str.
+     */
+    StaticString(const char* str) : StaticString() {
+        append(str);
+    }
+
+    /**
+     * @brief Append the first len characters of str.
+     *
+     * @return An error if they did not all fit, void otherwise.
+     */
+    ErrorUnion<void> append(const char* str, size_t len) {
+        memcpy(data + length, str, len < C - length ? len : C - length);
+        return truncatedBy(len);
+    }
+
+    ErrorUnion<void> append(const char* str) {
+        return append(str, strlen(str));
+    }
+
+    ErrorUnion<void> append(char c) {
+        return append(&c, 1);
+    }
+
+    ErrorUnion<void> append(const BufferView<char>& view) {
+        return append(view.cArr(), view.size());
+    }
+
+    template<size_t N>
+    ErrorUnion<void> append(const StaticString<N>& other) {
+        return append(other.cStr(), other.size());
+    }
+
+    /**
+     * @brief Append args formatted under the printf style fmt, see Format.hpp. Use META_CHECK_FORMAT to check a
+     *         literal fmt at compile time.
+     *
+     * @return An error if the output did not all fit, void otherwise.
+     */
+    template<typename... Args>
+    ErrorUnion<void> format(const char* fmt, const Args&... args) {
+        return truncatedBy(Format::write(data + length, C - length, fmt, args...));
+    }
+
+    /**
+     * @brief Shorten the string to at most len characters.
+     */
+    void truncate(size_t len) {
+        if (len < length) {
+            length = len;
+            data[length] = '\0';
+        }
+    }
+
+    /**
+     * @brief Where the next character goes, for writing into the string directly.
+     */
+    char* tail() {
+        return data + length;
+    }
+
+    /**
+     * @brief How many more characters fit.
+     */
+    size_t remaining() const {
+        return C - length;
+    }
+
+    /**
+     * @brief Account for n characters written through tail(), clamped to the space that was left.
+     *
+     * @return An error if n did not all fit, void otherwise.
+     */
+    ErrorUnion<void> advance(size_t n) {
+        return truncatedBy(n);
+    }
+
+    /**
+     * @brief Reset a string to its default state.
+     */
+    void clear() {
+        length = 0;
+        data[0] = '\0';
+    }
+
+    char operator[](size_t idx) const {
+        return data[idx];
+    }
+
+    bool operator==(const char* str) const {
+        return strncmp(data, str, length) == 0 && str[length] == '\0';
+    }
+
+    bool operator!=(const char* str) const {
+        return !(*this == str);
+    }
+
+    template<size_t N>
+    bool operator==(const StaticString<N>& other) const {
+        return length == other.size() && memcmp(data, other.cStr(), length) == 0;
+    }
+
+    template<size_t N>
+    bool operator!=(const StaticString<N>& other) const {
+        return !(*this == other);
+    }
+
+    /**
+     * @brief Get a (zero-copy) view over the characters, without the terminator.
+     */
+    BufferView<char> view() const {
+        return BufferView<char>(data, length);
+    }
+
+    const char* cStr() const {
+        return data;
+    }
+
+    size_t size() const {
+        return length;
+    }
+
+    bool empty() const {
+        return length == 0;
+    }
+
+    bool full() const {
+        return length == C;
+    }
+
+    static constexpr size_t capacity() {
+        return C;
+    }
+};
+
+}
@@ -1,24 +1,69 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
-#include <cstdlib>
+#if __cplusplus >= 202002L
+#include <bit>
+#endif
+#include <cstring>
 #include <limits>
 #include <cstdint>
+#include <type_traits>
+#include "Constexpr.hpp"
+#include "Endian.hpp"
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
 
 namespace Meta {
+    /**
+     * @brief A constexpr PCG32 (XSH RR) generator, for tables and test data computed at compile time. Unlike
+     *         std::rand it carries its own state, so the same seed yields the same sequence everywhere.
+     */
+    class Pcg32 {
+    private:
+        uint64_t state;
+        uint64_t increment; // Selects the stream, always odd
+
+    public:
+        constexpr Pcg32(uint64_t seed = 0x853C49E6748FEA9Bull, uint64_t stream = 0xDA3E39CB94B95BDBull)
+            : state(0), increment((stream << 1) | 1) {
+            next();
+            state += seed;
+            next();
+        }
+
+        constexpr uint32_t next() {
+            const uint64_t old = state;
+            state = old * 6364136223846793005ull + increment;
+            const uint32_t xorShifted = (uint32_t)(((old >> 18) ^ old) >> 27);
+            const uint32_t rot = (uint32_t)(old >> 59);
+            return (xorShifted >> rot) | (xorShifted << ((32 - rot) & 31));
+        }
+
+        constexpr uint64_t next64() {
+            const uint64_t high = next();
+            return (high << 32) | next();
+        }
+    };
+
     template<typename T, size_t N, size_t seed = 0x69>
     static constexpr std::array<T, N> randomArray() {
-        std::srand(seed);
-        std::array<T, N> arr;
+        static_assert(std::is_integral<T>::value, "Random arrays can only hold integral values.");
+        Pcg32 rng(seed);
+        std::array<T, N> arr = {};
         for (size_t i = 0; i < N; i++) {
-            arr[i] = std::rand() % std::numeric_limits<T>::max();
+            arr[i] = (T)(rng.next64() % (uint64_t)std::numeric_limits<T>::max());
         }
         return arr;
     }
 
     template<typename T, size_t N>
     static constexpr std::array<T, N> range() {
-        std::array<T, N> arr;
+        std::array<T, N> arr = {};
         for (size_t i = 0; i < N; i++) {
             arr[i] = i % std::numeric_limits<T>::max();
         }
@@ -27,32 +72,233 @@ namespace Meta {
 
     template <typename T, size_t N>
     static constexpr std::array<T, N> repeat(T t) {
-        std::array<T, N> arr;
+        std::array<T, N> arr = {};
         for (size_t i = 0; i < N; i++) {
             arr[i] = t;
         }
         return arr;
     }
 
-    template<typename T>
+    /**
+     * @brief Build a lookup table from a constexpr generator, e.g. at compile time into a constexpr (flash) table.
+     *
+     * @param f Called with each index 0..N-1, returns the entry.
+     */
+    template<typename T, size_t N, typename F>
+    static constexpr std::array<T, N> makeTable(F f) {
+        std::array<T, N> table = {};
+        for (size_t i = 0; i < N; i++) {
+            table[i] = f(i);
+        }
+        return table;
+    }
+
+    /**
+     * @brief The 256 entry byte-at-a-time lookup table of a CRC.
+     *
+     * @tparam T An unsigned type at least as wide as the CRC.
+     * @tparam Width The width of the CRC in bits.
+     * @tparam Poly The generator polynomial, in normal (MSB first) notation.
+     * @tparam Reflected Whether the CRC is computed LSB first, e.g. CRC-32 and CRC-32C.
+     */
+    template<typename T, size_t Width, T Poly, bool Reflected>
+    static constexpr std::array<T, 256> crcTable() {
+        static_assert(std::is_unsigned<T>::value && Width <= sizeof(T) * 8 && Width >= 8,
+                      "CRC tables need an unsigned type wide enough for a CRC of at least 8 bits.");
+        constexpr T mask = Width == sizeof(T) * 8 ? (T)~(T)0 : (T)(((T)1 << Width) - 1);
+        constexpr T top = (T)((T)1 << (Width - 1));
+
+        // The reflected polynomial, for LSB first tables
+        T reflectedPoly = 0;
+        for (size_t bit = 0; bit < Width; bit++) {
+            if (Poly & ((T)1 << bit)) {
+                reflectedPoly |= (T)((T)1 << (Width - 1 - bit));
+            }
+        }
+
+        std::array<T, 256> table = {};
+        for (size_t i = 0; i < 256; i++) {
+            T crc = 0;
+            if constexpr (Reflected) {
+                crc = (T)i;
+                for (size_t bit = 0; bit < 8; bit++) {
+                    crc = (T)((crc & 1) ? (crc >> 1) ^ reflectedPoly : crc >> 1);
+                }
+            } else {
+                crc = (T)((T)i << (Width - 8));
+                for (size_t bit = 0; bit < 8; bit++) {
+                    crc = (T)((crc & top) ? (T)(crc << 1) ^ Poly : (T)(crc << 1));
+                }
+            }
+            table[i] = (T)(crc & mask);
+        }
+        return table;
+    }
+
+    namespace Detail {
+        /**
+         * @brief Copy n Size byte elements from in to out, reversing the bytes of each. Sixteen bytes go per step
+         *         with SSSE3 or NEON byte shuffles, the rest through the compiler's byte swap builtins.
+         */
+        template<size_t Size>
+        inline void swapBytes(const uint8_t* in, size_t n, uint8_t* out) {
+            static_assert(Size == 2 || Size == 4 || Size == 8, "Only 2, 4 and 8 byte elements can be swapped in bulk.");
+            size_t i = 0;
+#if defined(__SSSE3__)
+            const __m128i order = Size == 2 ? _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14)
+                                : Size == 4 ? _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12)
+                                            : _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+            for (; (i + 16 / Size) <= n; i += 16 / Size) {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i * Size));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * Size), _mm_shuffle_epi8(v, order));
+            }
+#elif defined(__ARM_NEON)
+            for (; (i + 16 / Size) <= n; i += 16 / Size) {
+                const uint8x16_t v = vld1q_u8(in + i * Size);
+                vst1q_u8(out + i * Size, Size == 2 ? vrev16q_u8(v) : Size == 4 ? vrev32q_u8(v) : vrev64q_u8(v));
+            }
+#endif
+            typedef typename std::conditional<Size == 2, uint16_t,
+                    typename std::conditional<Size == 4, uint32_t, uint64_t>::type>::type Word;
+            for (; i < n; i++) {
+                Word w;
+                memcpy(&w, in + i * Size, Size);
+                w = byteSwap(w);
+                memcpy(out + i * Size, &w, Size);
+            }
+        }
+    }
+
+    /**
+     * @brief Write the bytes of t into out in the given byte order. Non-arithmetic (POD) types can only be written
+     *         in native order.
+     */
+    template<typename T, Endian E = Endian::Little>
+    static inline META_CONSTEXPR20 void storeBytes(const T& t, uint8_t* out) {
+        static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be serialized.");
+#if __cplusplus >= 202002L
+        if (isConstantEvaluated()) {
+            const auto bytes = std::bit_cast<std::array<uint8_t, sizeof(T)>>(t);
+            for (size_t i = 0; i < sizeof(T); i++) {
+                const bool swap = E != Endian::Native && (std::is_arithmetic<T>::value || std::is_enum<T>::value);
+                out[i] = bytes[swap ? sizeof(T) - 1 - i : i];
+            }
+            return;
+        }
+#endif
+        if constexpr (std::is_integral<T>::value || std::is_enum<T>::value) {
+            const T swapped = toEndian<E>(t);
+            memcpy(out, &swapped, sizeof(T));
+        } else {
+            static_assert(E == Endian::Native || sizeof(T) == 1 || std::is_floating_point<T>::value,
+                          "Only arithmetic types can be serialized in a non-native byte order.");
+            memcpy(out, &t, sizeof(T));
+            if constexpr (E != Endian::Native) {
+                std::reverse(out, out + sizeof(T));
+            }
+        }
+    }
+
+    /**
+     * @brief Write n Ts into out in the given byte order, as a single bulk copy when no conversion is needed and as a
+     *         bulk byte swap otherwise. POD structs are always written in native order.
+     */
+    template<typename T, Endian E = Endian::Little>
+    static inline META_CONSTEXPR20 void storeBytes(const T* arr, size_t n, uint8_t* out) {
+        static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be serialized.");
+        constexpr bool swap = E != Endian::Native && sizeof(T) > 1 && (std::is_arithmetic<T>::value || std::is_enum<T>::value);
+        if (isConstantEvaluated()) {
+            for (size_t i = 0; i < n; i++) {
+                storeBytes<T, swap ? E : Endian::Native>(arr[i], out + i * sizeof(T));
+            }
+        } else if constexpr (!swap) {
+            if (n) {
+                memcpy(out, arr, n * sizeof(T));
+            }
+        } else if constexpr (sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8) {
+            Detail::swapBytes<sizeof(T)>(reinterpret_cast<const uint8_t*>(arr), n, out);
+        } else {
+            for (size_t i = 0; i < n; i++) {
+                storeBytes<T, E>(arr[i], out + i * sizeof(T));
+            }
+        }
+    }
+
+    /**
+     * @brief Read a T written in the given byte order from in, the reverse of storeBytes.
+     */
+    template<typename T, Endian E = Endian::Little>
+    static inline META_CONSTEXPR20 T loadBytes(const uint8_t* in) {
+        static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be deserialized.");
+        constexpr bool swap = E != Endian::Native && sizeof(T) > 1;
+#if __cplusplus >= 202002L
+        if (isConstantEvaluated()) {
+            std::array<uint8_t, sizeof(T)> bytes = {};
+            for (size_t i = 0; i < sizeof(T); i++) {
+                bytes[i] = in[swap ? sizeof(T) - 1 - i : i];
+            }
+            return std::bit_cast<T>(bytes);
+        }
+#endif
+        T t;
+        if constexpr (std::is_integral<T>::value || std::is_enum<T>::value) {
+            memcpy(&t, in, sizeof(T));
+            t = toEndian<E>(t);
+        } else {
+            static_assert(!swap || std::is_floating_point<T>::value,
+                          "Only arithmetic types can be deserialized from a non-native byte order.");
+            uint8_t bytes[sizeof(T)];
+            memcpy(bytes, in, sizeof(T));
+            if constexpr (swap) {
+                std::reverse(bytes, bytes + sizeof(T));
+            }
+            memcpy(&t, bytes, sizeof(T));
+        }
+        return t;
+    }
+
+    /**
+     * @brief Read n Ts written in the given byte order from in, the reverse of the bulk storeBytes.
+     */
+    template<typename T, Endian E = Endian::Little>
+    static inline META_CONSTEXPR20 void loadBytes(const uint8_t* in, size_t n, T* arr) {
+        static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be deserialized.");
+        constexpr bool swap = E != Endian::Native && sizeof(T) > 1 && (std::is_arithmetic<T>::value || std::is_enum<T>::value);
+        if (isConstantEvaluated()) {
+            for (size_t i = 0; i < n; i++) {
+                arr[i] = loadBytes<T, swap ? E : Endian::Native>(in + i * sizeof(T));
+            }
+        } else if constexpr (!swap) {
+            if (n) {
+                memcpy(arr, in, n * sizeof(T));
+            }
+        } else if constexpr (sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8) {
+            Detail::swapBytes<sizeof(T)>(in, n, reinterpret_cast<uint8_t*>(arr));
+        } else {
+            for (size_t i = 0; i < n; i++) {
+                arr[i] = loadBytes<T, E>(in + i * sizeof(T));
+            }
+        }
+    }
+
+    template<typename T, Endian E = Endian::Little>
     static constexpr std::array<uint8_t, sizeof(T)> getBytes(const T& t) {
-        std::array<uint8_t, sizeof(T)> bytes;
-        for (size_t i = 0; i < sizeof(T); i++) {
-            bytes[i] = (t >> (i * 8)) & 0xFF;
+        std::array<uint8_t, sizeof(T)> bytes = {};
+        if constexpr (std::is_integral<T>::value) {
+            for (size_t i = 0; i < sizeof(T); i++) {
+                const size_t shift = E == Endian::Little ? i : sizeof(T) - 1 - i;
+                bytes[i] = (t >> (shift * 8)) & 0xFF;
+            }
+        } else {
+            storeBytes<T, E>(t, bytes.data());
         }
         return bytes;
     }
 
-    template<typename T, size_t N>
+    template<typename T, size_t N, Endian E = Endian::Little>
     static std::array<uint8_t, N * sizeof(T)> toByteArray(const std::array<T, N>& arr) {
         std::array<uint8_t, N * sizeof(T)> bytes;
-        size_t bIdx = 0;
-        for (auto t : arr) {
-            auto elementBytes = getBytes(t);
-            std::copy(elementBytes.begin(), elementBytes.end(), bytes.begin() + bIdx);
-            bIdx += elementBytes.size();
-        }
+        storeBytes<T, E>(arr.data(), N, bytes.data());
         return bytes;
     }
 }
-
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief Marks functions that can only be constexpr under C++20 (unions, destructors, placement construction).
+ */
+#if __cplusplus >= 202002L
+#define META_CONSTEXPR20 constexpr
+#else
+#define META_CONSTEXPR20
+#endif
+
+/**
+ * @brief Defined when isConstantEvaluated() can actually tell, so compile-time-only checks can be skipped elsewhere.
+ */
+#if defined(__cpp_lib_is_constant_evaluated) || defined(__GNUC__) || defined(__clang__)
+#define META_HAS_CONSTANT_EVALUATED 1
+#endif
+
+/**
+ * @brief The cache line size of the target in bytes: the alignment that keeps data written by different cores on
+ *         separate lines, and that full-width SIMD loads never straddle.
+ */
+#ifndef META_CACHE_LINE_SIZE
+#define META_CACHE_LINE_SIZE 64
+#endif
+
+namespace Meta {
+    /**
+     * @brief Whether the call is being evaluated at compile time, so that memcpy style fast paths can fall back to
+     *         plain loops there. Always false on compilers that cannot tell.
+     */
+    constexpr bool isConstantEvaluated() noexcept {
+#if defined(__cpp_lib_is_constant_evaluated)
+        return std::is_constant_evaluated();
+#elif defined(META_HAS_CONSTANT_EVALUATED)
+        return __builtin_is_constant_evaluated();
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * @brief Placement new, usable in constant expressions under C++20.
+     */
+    template<typename T, typename... Args>
+    META_CONSTEXPR20 T* constructAt(T* p, Args&&... args) {
+#if __cplusplus >= 202002L
+        return std::construct_at(p, std::forward<Args>(args)...);
+#else
+        return new (p) T(std::forward<Args>(args)...);
+#endif
+    }
+}
@@ -0,0 +1,272 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include "../Structures/BufferView.hpp"
+#include "ArrayUtils.hpp"
+#include "Constexpr.hpp"
+#include "Endian.hpp"
+
+#if defined(__SSE4_2__)
+#include <nmmintrin.h>
+#elif defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#endif
+
+/**
+ * @brief How many bytes the software CRC kernels consume per step: 8 (slicing-by-8, eight 256 entry tables per CRC
+ *         type) or 1 (a single table, for targets where flash matters more than throughput).
+ */
+#ifndef META_CRC_SLICE_BY
+#define META_CRC_SLICE_BY 8
+#endif
+
+namespace Meta {
+    namespace Detail {
+        /**
+         * @brief The smallest unsigned type holding a CRC of the given width.
+         */
+        template<size_t Width>
+        using CrcType = typename std::conditional<Width <= 8, uint8_t,
+                        typename std::conditional<Width <= 16, uint16_t,
+                        typename std::conditional<Width <= 32, uint32_t, uint64_t>::type>::type>::type;
+
+        /**
+         * @brief The byte-at-a-time CRC table followed by Slices - 1 tables that each advance it a further zero byte,
+         *         for consuming Slices bytes per step.
+         */
+        template<typename T, size_t Width, T Poly, bool Reflected, size_t Slices>
+        static constexpr std::array<std::array<T, 256>, Slices> crcSlicingTables() {
+            constexpr T mask = (T)(Width == 64 ? ~0ull : (1ull << Width) - 1);
+            std::array<std::array<T, 256>, Slices> tables = {};
+            tables[0] = crcTable<T, Width, Poly, Reflected>();
+            for (size_t k = 1; k < Slices; k++) {
+                for (size_t i = 0; i < 256; i++) {
+                    const T prev = tables[k - 1][i];
+                    if constexpr (Reflected) {
+                        tables[k][i] = (T)((Width > 8 ? prev >> 8 : 0) ^ tables[0][prev & 0xFF]);
+                    } else {
+                        tables[k][i] = (T)(((Width > 8 ? prev << 8 : 0) & mask) ^ tables[0][(prev >> (Width - 8)) & 0xFF]);
+                    }
+                }
+            }
+            return tables;
+        }
+
+        /**
+         * @brief The low width bits of v in reverse order.
+         */
+        static constexpr uint64_t reflect(uint64_t v, size_t width) {
+            uint64_t r = 0;
+            for (size_t bit = 0; bit < width; bit++) {
+                r |= ((v >> bit) & 1) << (width - 1 - bit);
+            }
+            return r;
+        }
+
+        static constexpr uint8_t CRC_CHECK_INPUT[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+
+#if defined(__SSE4_2__)
+        /**
+         * @brief CRC-32C through the SSE4.2 crc32 instruction, on the raw (reflected, not inverted) register.
+         */
+        inline uint32_t crc32cHardware(uint32_t crc, const uint8_t* bytes, size_t len) {
+#if defined(__x86_64__)
+            uint64_t wide = crc;
+            for (; len >= 8; bytes += 8, len -= 8) {
+                uint64_t word;
+                memcpy(&word, bytes, 8);
+                wide = _mm_crc32_u64(wide, word);
+            }
+            crc = (uint32_t)wide;
+#endif
+            for (; len >= 4; bytes += 4, len -= 4) {
+                uint32_t word;
+                memcpy(&word, bytes, 4);
+                crc = _mm_crc32_u32(crc, word);
+            }
+            for (; len > 0; bytes++, len--) {
+                crc = _mm_crc32_u8(crc, *bytes);
+            }
+            return crc;
+        }
+#elif defined(__ARM_FEATURE_CRC32)
+        /**
+         * @brief CRC-32 (or CRC-32C) through the ARMv8 CRC32 instructions, on the raw (reflected, not inverted)
+         *         register.
+         */
+        template<bool Castagnoli>
+        inline uint32_t crc32Hardware(uint32_t crc, const uint8_t* bytes, size_t len) {
+            for (; len >= 8; bytes += 8, len -= 8) {
+                uint64_t word;
+                memcpy(&word, bytes, 8);
+                crc = Castagnoli ? __crc32cd(crc, word) : __crc32d(crc, word);
+            }
+            for (; len > 0; bytes++, len--) {
+                crc = Castagnoli ? __crc32cb(crc, *bytes) : __crc32b(crc, *bytes);
+            }
+            return crc;
+        }
+#endif
+    }
+
+    /**
+     * @brief A CRC with compile time generated lookup tables, in the usual (Rocksoft) parameterization.
+     *
+     * Instances hold a running CRC, so a frame arriving in pieces can be checked without reassembling it first:
+     *  update() with each piece, then value(). compute() does a whole message at once. Both are constexpr. At
+     *  runtime CRC-32C uses the SSE4.2 crc32 instruction, and CRC-32/CRC-32C the ARMv8 CRC32 instructions, when the
+     *  target is compiled with them; everything else runs slicing-by-8 over the tables.
+     *
+     * @tparam Width The width of the CRC in bits, a multiple of 8 up to 64.
+     * @tparam Poly The generator polynomial, in normal (MSB first) notation.
+     * @tparam Init The register's value before the first byte.
+     * @tparam Reflected Whether bytes are processed LSB first (and the result reflected), e.g. CRC-32.
+     * @tparam XorOut What the final register is XORed with.
+     */
+    template<size_t Width, uint64_t Poly, uint64_t Init = 0, bool Reflected = false, uint64_t XorOut = 0>
+    class Crc {
+        static_assert(Width % 8 == 0 && Width >= 8 && Width <= 64, "CRCs must be a whole number of bytes wide.");
+        static_assert(META_CRC_SLICE_BY == 1 || META_CRC_SLICE_BY == 8, "META_CRC_SLICE_BY must be 1 or 8.");
+
+    public:
+        typedef Detail::CrcType<Width> Value;
+
+    private:
+        static constexpr Value MASK = (Value)(Width == 64 ? ~0ull : (1ull << Width) - 1);
+        static constexpr size_t SLICES = META_CRC_SLICE_BY;
+        // Reflected CRCs keep the register reflected, so Init has to be loaded that way too
+        static constexpr Value INITIAL = (Value)((Reflected ? Detail::reflect(Init, Width) : Init) & MASK);
+
+        static constexpr std::array<std::array<Value, 256>, SLICES> TABLES =
+            Detail::crcSlicingTables<Value, Width, (Value)Poly, Reflected, SLICES>();
+
+        static constexpr bool IS_CRC32 = Width == 32 && Reflected && Poly == 0x04C11DB7;
+        static constexpr bool IS_CRC32C = Width == 32 && Reflected && Poly == 0x1EDC6F41;
+
+        Value state;
+
+        static constexpr Value updateBytes(Value crc, const uint8_t* bytes, size_t len) {
+            for (size_t i = 0; i < len; i++) {
+                if constexpr (Reflected) {
+                    crc = (Value)((Width > 8 ? crc >> 8 : 0) ^ TABLES[0][(crc ^ bytes[i]) & 0xFF]);
+                } else {
+                    crc = (Value)(((Width > 8 ? crc << 8 : 0) & MASK) ^ TABLES[0][((crc >> (Width - 8)) ^ bytes[i]) & 0xFF]);
+                }
+            }
+            return crc;
+        }
+
+        static Value updateSliced(Value crc, const uint8_t* bytes, size_t len) {
+            if constexpr (SLICES == 8) {
+                const auto& t = TABLES;
+                for (; len >= 8; bytes += 8, len -= 8) {
+                    uint64_t x;
+                    memcpy(&x, bytes, 8);
+                    // The register lines up with the first Width / 8 bytes, so it folds into the word
+                    if constexpr (Reflected) {
+                        x = toEndian<Endian::Little>(x) ^ (uint64_t)crc;
+                        crc = (Value)(t[7][x & 0xFF] ^ t[6][(x >> 8) & 0xFF] ^ t[5][(x >> 16) & 0xFF] ^
+                                      t[4][(x >> 24) & 0xFF] ^ t[3][(x >> 32) & 0xFF] ^ t[2][(x >> 40) & 0xFF] ^
+                                      t[1][(x >> 48) & 0xFF] ^ t[0][x >> 56]);
+                    } else {
+                        x = toEndian<Endian::Big>(x) ^ ((uint64_t)crc << (64 - Width));
+                        crc = (Value)(t[7][x >> 56] ^ t[6][(x >> 48) & 0xFF] ^ t[5][(x >> 40) & 0xFF] ^
+                                      t[4][(x >> 32) & 0xFF] ^ t[3][(x >> 24) & 0xFF] ^ t[2][(x >> 16) & 0xFF] ^
+                                      t[1][(x >> 8) & 0xFF] ^ t[0][x & 0xFF]);
+                    }
+                }
+            }
+            return updateBytes(crc, bytes, len);
+        }
+
+        static Value updateFast(Value crc, const uint8_t* bytes, size_t len) {
+#if defined(__SSE4_2__)
+            if constexpr (IS_CRC32C) {
+                return (Value)Detail::crc32cHardware((uint32_t)crc, bytes, len);
+            } else
+#elif defined(__ARM_FEATURE_CRC32)
+            if constexpr (IS_CRC32 || IS_CRC32C) {
+                return (Value)Detail::crc32Hardware<IS_CRC32C>((uint32_t)crc, bytes, len);
+            } else
+#endif
+            {
+                return updateSliced(crc, bytes, len);
+            }
+        }
+
+    public:
+        /**
+         * @brief Start a new CRC.
+         */
+        constexpr Crc() : state(INITIAL) {}
+
+        /**
+         * @brief Feed the next len bytes of the message.
+         */
+        constexpr Crc& update(const uint8_t* bytes, size_t len) {
+            if (isConstantEvaluated()) {
+                state = updateBytes(state, bytes, len);
+            } else {
+                state = updateFast(state, bytes, len);
+            }
+            return *this;
+        }
+
+        constexpr Crc& update(const BufferView<uint8_t>& view) {
+            return update(view.cArr(), view.size());
+        }
+
+        /**
+         * @brief The CRC of every byte fed so far. More bytes may still be fed afterwards.
+         */
+        constexpr Value value() const {
+            return (Value)((state ^ XorOut) & MASK);
+        }
+
+        /**
+         * @brief Start over, forgetting every byte fed.
+         */
+        constexpr void reset() {
+            state = INITIAL;
+        }
+
+        /**
+         * @brief The CRC of a whole message.
+         */
+        static constexpr Value compute(const uint8_t* bytes, size_t len) {
+            Crc crc;
+            crc.update(bytes, len);
+            return crc.value();
+        }
+
+        static constexpr Value compute(const BufferView<uint8_t>& view) {
+            return compute(view.cArr(), view.size());
+        }
+
+        /**
+         * @brief The CRC of "123456789", the standard check value catalogues list for each CRC.
+         */
+        static constexpr Value check() {
+            return compute(Detail::CRC_CHECK_INPUT, sizeof(Detail::CRC_CHECK_INPUT));
+        }
+    };
+
+    typedef Crc<8, 0x07> Crc8; // CRC-8/SMBUS
+    typedef Crc<16, 0x1021, 0xFFFF> Crc16Ccitt; // CRC-16/CCITT-FALSE (IBM-3740)
+    typedef Crc<16, 0x8005, 0xFFFF, true> Crc16Modbus; // CRC-16/MODBUS
+    typedef Crc<32, 0x04C11DB7, 0xFFFFFFFF, true, 0xFFFFFFFF> Crc32; // CRC-32 (Ethernet, zlib, PNG)
+    typedef Crc<32, 0x1EDC6F41, 0xFFFFFFFF, true, 0xFFFFFFFF> Crc32C; // CRC-32C (Castagnoli, iSCSI, ext4)
+
+#if defined(META_HAS_CONSTANT_EVALUATED)
+    static_assert(Crc8::check() == 0xF4, "CRC-8 tables are broken.");
+    static_assert(Crc16Ccitt::check() == 0x29B1, "CRC-16/CCITT-FALSE tables are broken.");
+    static_assert(Crc16Modbus::check() == 0x4B37, "CRC-16/MODBUS tables are broken.");
+    static_assert(Crc32::check() == 0xCBF43926, "CRC-32 tables are broken.");
+    static_assert(Crc32C::check() == 0xE3069283, "CRC-32C tables are broken.");
+    static_assert(Crc<16, 0x1021, 0xB2AA, true>::check() == 0x63D0, "Reflected CRCs load Init unreflected."); // CRC-16/RIELLO
+#endif
+}
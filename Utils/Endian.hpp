@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace Meta {
+    /**
+     * @brief Byte order policy for serializing multi-byte values.
+     */
+    enum class Endian {
+        Little,
+        Big,
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        Native = Big,
+#else
+        Native = Little,
+#endif
+    };
+
+    /**
+     * @brief Reverse the byte order of an integral (or enum) value.
+     */
+    template<typename T>
+    constexpr T byteSwap(T t) {
+        static_assert(std::is_integral<T>::value || std::is_enum<T>::value, "Only integral values can be byte swapped.");
+        if constexpr (std::is_enum<T>::value) {
+            using U = typename std::underlying_type<T>::type;
+            return static_cast<T>(byteSwap(static_cast<U>(t)));
+        } else if constexpr (sizeof(T) == 1) {
+            return t;
+#if defined(__GNUC__) || defined(__clang__)
+        } else if constexpr (sizeof(T) == 2) {
+            return static_cast<T>(__builtin_bswap16(static_cast<uint16_t>(t)));
+        } else if constexpr (sizeof(T) == 4) {
+            return static_cast<T>(__builtin_bswap32(static_cast<uint32_t>(t)));
+        } else if constexpr (sizeof(T) == 8) {
+            return static_cast<T>(__builtin_bswap64(static_cast<uint64_t>(t)));
+#endif
+        } else {
+            using U = typename std::make_unsigned<T>::type;
+            U u = static_cast<U>(t);
+            U swapped = 0;
+            for (size_t i = 0; i < sizeof(T); i++) {
+                swapped = (U)((swapped << 8) | (u & 0xFF));
+                u = (U)(u >> 8);
+            }
+            return static_cast<T>(swapped);
+        }
+    }
+
+    /**
+     * @brief Convert a native value into (or back out of) the given byte order.
+     */
+    template<Endian E, typename T>
+    constexpr T toEndian(T t) {
+        if constexpr (E == Endian::Native || sizeof(T) == 1) {
+            return t;
+        } else {
+            return byteSwap(t);
+        }
+    }
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+namespace Meta {
+    /**
+     * @brief A list of struct fields as member pointers, e.g. Fields<&Header::type, &Header::length>.
+     */
+    template<auto... Members>
+    struct Fields {};
+
+    namespace Detail {
+        template<typename P>
+        struct MemberPointer;
+
+        template<typename S, typename T>
+        struct MemberPointer<T S::*> {
+            typedef S Struct;
+            typedef T Type;
+        };
+
+        template<auto A, auto B>
+        constexpr bool sameMember() {
+            if constexpr (std::is_same<decltype(A), decltype(B)>::value) {
+                return A == B;
+            } else {
+                return false;
+            }
+        }
+
+        /**
+         * @brief Where Member sits in Members, or sizeof...(Members) if it is not there.
+         */
+        template<auto Member, auto... Members>
+        constexpr size_t memberIndex() {
+            constexpr bool matches[] = {sameMember<Member, Members>()..., false};
+            size_t i = 0;
+            while (i < sizeof...(Members) && !matches[i]) {
+                i++;
+            }
+            return i;
+        }
+    }
+}
@@ -0,0 +1,530 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace Meta {
+    /**
+     * @brief A printf style formatter for fixed size buffers, without locales, allocation or varargs.
+     *
+     * The supported subset is %d %i %u %c %x %X %s %p %f and %%, with the -, +, space, 0 and # flags, a width and a
+     *  precision. Length modifiers (hh, h, l, ll, z, j, t) are accepted and ignored: every argument is formatted as
+     *  the type it actually has, so a mismatched modifier is never undefined behavior. check() verifies a format
+     *  string against its argument types in a constant expression, and the LOG macros do so for every call.
+     *
+     * %f works in double arithmetic rather than printf's exact decimal expansion, so digits past the 15th or so
+     *  significant one may differ.
+     */
+    namespace Format {
+        namespace Detail {
+            typedef enum : uint8_t {
+                ARG_SIGNED = 0,
+                ARG_UNSIGNED = 1,
+                ARG_FLOAT = 2,
+                ARG_STRING = 3,
+                ARG_POINTER = 4,
+                ARG_NONE = 5, // Only terminates argument lists
+            } ArgKind;
+
+            template<typename... Args>
+            struct TypeList {};
+
+            /**
+             * @brief The (decayed) types of a list of expressions, for use in decltype only.
+             */
+            template<typename... Args>
+            TypeList<typename std::decay<Args>::type...> argTypes(const Args&...);
+
+            template<typename T>
+            constexpr ArgKind kindOf() {
+                typedef typename std::decay<T>::type D;
+                if constexpr (std::is_same<D, const char*>::value || std::is_same<D, char*>::value) {
+                    return ARG_STRING;
+                } else if constexpr (std::is_pointer<D>::value || std::is_same<D, std::nullptr_t>::value) {
+                    return ARG_POINTER;
+                } else if constexpr (std::is_floating_point<D>::value) {
+                    return ARG_FLOAT;
+                } else if constexpr (std::is_enum<D>::value) {
+                    return kindOf<typename std::underlying_type<D>::type>();
+                } else if constexpr (std::is_integral<D>::value) {
+                    return std::is_signed<D>::value ? ARG_SIGNED : ARG_UNSIGNED;
+                } else {
+                    static_assert(sizeof(D) == 0, "Format arguments must be arithmetic, enums, pointers or C strings.");
+                    return ARG_NONE;
+                }
+            }
+
+            /**
+             * @brief A single argument with its type erased, so the formatting loop is only instantiated once.
+             */
+            typedef struct {
+                ArgKind kind;
+                uint8_t size; // Of the original integer type, for writing negative values in hex
+                union {
+                    int64_t i;
+                    uint64_t u;
+                    double f;
+                    const char* s;
+                    const void* p;
+                };
+            } Arg;
+
+            template<typename T>
+            inline Arg toArg(const T& t) {
+                constexpr ArgKind kind = kindOf<T>();
+                Arg arg;
+                arg.kind = kind;
+                arg.size = (uint8_t)sizeof(T);
+                if constexpr (kind == ARG_STRING) {
+                    arg.s = t;
+                } else if constexpr (kind == ARG_POINTER) {
+                    arg.p = static_cast<const void*>(t);
+                } else if constexpr (kind == ARG_FLOAT) {
+                    arg.f = (double)t;
+                } else if constexpr (kind == ARG_SIGNED) {
+                    arg.i = (int64_t)t;
+                } else {
+                    arg.u = (uint64_t)t;
+                }
+                return arg;
+            }
+
+            /**
+             * @brief One parsed conversion specification.
+             */
+            typedef struct {
+                bool left; // '-'
+                bool plus; // '+'
+                bool space; // ' '
+                bool zero; // '0'
+                bool alternate; // '#'
+                size_t width;
+                int precision; // -1 if none was given
+                char conversion;
+            } Spec;
+
+            /**
+             * @brief Parse the specification starting at the '%' at fmt[i], leaving i just past it.
+             *
+             * @return Whether it is one of the supported conversions. i always moves forward.
+             */
+            constexpr bool parseSpec(const char* fmt, size_t& i, Spec& spec) {
+                spec = Spec{false, false, false, false, false, 0, -1, '\0'};
+                i++;
+                for (;; i++) {
+                    if (fmt[i] == '-') spec.left = true;
+                    else if (fmt[i] == '+') spec.plus = true;
+                    else if (fmt[i] == ' ') spec.space = true;
+                    else if (fmt[i] == '0') spec.zero = true;
+                    else if (fmt[i] == '#') spec.alternate = true;
+                    else break;
+                }
+                for (; fmt[i] >= '0' && fmt[i] <= '9'; i++) {
+                    spec.width = spec.width * 10 + (size_t)(fmt[i] - '0');
+                }
+                if (fmt[i] == '.') {
+                    spec.precision = 0;
+                    for (i++; fmt[i] >= '0' && fmt[i] <= '9'; i++) {
+                        spec.precision = spec.precision * 10 + (fmt[i] - '0');
+                    }
+                }
+                while (fmt[i] == 'h' || fmt[i] == 'l' || fmt[i] == 'z' || fmt[i] == 'j' || fmt[i] == 't') {
+                    i++;
+                }
+                spec.conversion = fmt[i];
+                switch (spec.conversion) {
+                    case 'd': case 'i': case 'u': case 'c': case 'x': case 'X':
+                    case 's': case 'p': case 'f': case '%':
+                        i++;
+                        return true;
+                    case '\0':
+                        return false;
+                    default:
+                        i++;
+                        return false;
+                }
+            }
+
+            constexpr bool accepts(char conversion, ArgKind kind) {
+                switch (conversion) {
+                    case 'd': case 'i': case 'u': case 'c': case 'x': case 'X':
+                        return kind == ARG_SIGNED || kind == ARG_UNSIGNED;
+                    case 'f':
+                        return kind == ARG_FLOAT;
+                    case 's':
+                        return kind == ARG_STRING;
+                    case 'p':
+                        return kind == ARG_POINTER || kind == ARG_STRING;
+                }
+                return false;
+            }
+
+            // Reaching one of these while check() is constant evaluated stops compilation, naming the problem
+            inline void unsupportedFormatSpecifier() {}
+            inline void tooFewFormatArguments() {}
+            inline void tooManyFormatArguments() {}
+            inline void formatArgumentTypeMismatch() {}
+
+            static constexpr std::array<char, 200> makeDecimalPairs() {
+                std::array<char, 200> pairs = {};
+                for (size_t i = 0; i < 100; i++) {
+                    pairs[2 * i] = (char)('0' + i / 10);
+                    pairs[2 * i + 1] = (char)('0' + i % 10);
+                }
+                return pairs;
+            }
+
+            /**
+             * @brief The two decimal characters of 0 to 99, generated at compile time. Also used by the timestamps.
+             */
+            static constexpr std::array<char, 200> DECIMAL_PAIRS = makeDecimalPairs();
+
+            static constexpr uint64_t POWERS_OF_TEN[] = {
+                1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull,
+                1000000000ull, 10000000000ull, 100000000000ull, 1000000000000ull, 10000000000000ull,
+                100000000000000ull, 1000000000000000ull, 10000000000000000ull, 100000000000000000ull,
+                1000000000000000000ull, 10000000000000000000ull,
+            };
+
+            static constexpr int MAX_PRECISION = 17;
+
+            /**
+             * @brief Collects the output, counting (but dropping) whatever does not fit.
+             */
+            class Output {
+            private:
+                char* out;
+                size_t capacity;
+                size_t length;
+
+            public:
+                Output(char* out, size_t capacity) : out(out), capacity(capacity), length(0) {}
+
+                // Pieces are mostly a few characters long, too short to be worth a memcpy call
+                void put(const char* str, size_t n) {
+                    const size_t fits = length < capacity ? (n < capacity - length ? n : capacity - length) : 0;
+                    for (size_t i = 0; i < fits; i++) {
+                        out[length + i] = str[i];
+                    }
+                    length += n;
+                }
+
+                void fill(char c, size_t n) {
+                    const size_t fits = length < capacity ? (n < capacity - length ? n : capacity - length) : 0;
+                    for (size_t i = 0; i < fits; i++) {
+                        out[length + i] = c;
+                    }
+                    length += n;
+                }
+
+                size_t size() const {
+                    return length;
+                }
+            };
+
+            /**
+             * @brief Write one field: padding, prefix (sign or 0x), zeros, then the body.
+             */
+            inline void field(Output& out, const Spec& spec, const char* prefix, size_t prefixLen, size_t zeros,
+                              const char* body, size_t bodyLen, bool zeroPad) {
+                const size_t len = prefixLen + zeros + bodyLen;
+                size_t pad = spec.width > len ? spec.width - len : 0;
+                if (zeroPad && spec.zero && !spec.left) {
+                    zeros += pad;
+                    pad = 0;
+                }
+                if (!spec.left) out.fill(' ', pad);
+                out.put(prefix, prefixLen);
+                out.fill('0', zeros);
+                out.put(body, bodyLen);
+                if (spec.left) out.fill(' ', pad);
+            }
+        }
+
+        /**
+         * @brief The largest number of characters writeDecimal() and writeHex() produce.
+         */
+        static constexpr size_t MAX_INTEGER_SIZE = 20;
+
+        /**
+         * @brief Write value in decimal, two digits per step.
+         *
+         * @param out Must hold at least MAX_INTEGER_SIZE characters. The digits are not null terminated.
+         * @return How many digits were written.
+         */
+        inline size_t writeDecimal(uint64_t value, char* out) {
+            size_t n = 1;
+            while (n < MAX_INTEGER_SIZE && value >= Detail::POWERS_OF_TEN[n]) {
+                n++;
+            }
+            size_t pos = n;
+            while (value >= 100) {
+                const size_t pair = (size_t)(value % 100) * 2;
+                value /= 100;
+                out[--pos] = Detail::DECIMAL_PAIRS[pair + 1];
+                out[--pos] = Detail::DECIMAL_PAIRS[pair];
+            }
+            if (value >= 10) {
+                out[--pos] = Detail::DECIMAL_PAIRS[value * 2 + 1];
+                out[--pos] = Detail::DECIMAL_PAIRS[value * 2];
+            } else {
+                out[--pos] = (char)('0' + value);
+            }
+            return n;
+        }
+
+        /**
+         * @brief Write value in hex without leading zeros.
+         *
+         * @param out Must hold at least MAX_INTEGER_SIZE characters. The digits are not null terminated.
+         * @return How many digits were written.
+         */
+        inline size_t writeHex(uint64_t value, char* out, bool upper = false) {
+            const char* digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+            size_t n = 1;
+            while (n < 16 && (value >> (4 * n))) {
+                n++;
+            }
+            for (size_t i = n; i > 0; i--) {
+                out[i - 1] = digits[value & 0x0F];
+                value >>= 4;
+            }
+            return n;
+        }
+
+        /**
+         * @brief Check fmt against the types of the arguments it will be given. In a constant expression a mismatch
+         *         fails to compile, with the reason in the name of the offending call.
+         *
+         * @return Whether every conversion is supported and accepts its argument, with none left over.
+         */
+        template<typename... Args>
+        constexpr bool check(Detail::TypeList<Args...>, const char* fmt) {
+            constexpr Detail::ArgKind kinds[] = {Detail::kindOf<Args>()..., Detail::ARG_NONE};
+            size_t next = 0;
+            size_t i = 0;
+            while (fmt[i]) {
+                if (fmt[i] != '%') {
+                    i++;
+                    continue;
+                }
+                Detail::Spec spec{};
+                if (!Detail::parseSpec(fmt, i, spec)) {
+                    Detail::unsupportedFormatSpecifier();
+                    return false;
+                }
+                if (spec.conversion == '%') {
+                    continue;
+                }
+                if (next >= sizeof...(Args)) {
+                    Detail::tooFewFormatArguments();
+                    return false;
+                }
+                if (!Detail::accepts(spec.conversion, kinds[next++])) {
+                    Detail::formatArgumentTypeMismatch();
+                    return false;
+                }
+            }
+            if (next != sizeof...(Args)) {
+                Detail::tooManyFormatArguments();
+                return false;
+            }
+            return true;
+        }
+
+        namespace Detail {
+            inline void writeInteger(Output& out, const Spec& spec, const Arg& arg) {
+                char body[MAX_INTEGER_SIZE];
+                char prefix[2] = {};
+                size_t prefixLen = 0;
+                size_t len;
+                if (spec.conversion == 'c') {
+                    body[0] = (char)arg.u;
+                    field(out, spec, prefix, 0, 0, body, 1, false);
+                    return;
+                }
+                if (spec.conversion == 'x' || spec.conversion == 'X') {
+                    // Negative values are written as their two's complement at their own width, like printf
+                    uint64_t bits = arg.u;
+                    if (arg.kind == ARG_SIGNED && arg.size < sizeof(uint64_t)) {
+                        bits &= (1ull << (8 * arg.size)) - 1;
+                    }
+                    len = writeHex(bits, body, spec.conversion == 'X');
+                    if (spec.alternate && bits) {
+                        prefix[prefixLen++] = '0';
+                        prefix[prefixLen++] = spec.conversion;
+                    }
+                } else if (arg.kind == ARG_SIGNED && arg.i < 0) {
+                    len = writeDecimal(0 - (uint64_t)arg.i, body);
+                    prefix[prefixLen++] = '-';
+                } else {
+                    len = writeDecimal(arg.u, body);
+                    if (spec.plus || spec.space) {
+                        prefix[prefixLen++] = spec.plus ? '+' : ' ';
+                    }
+                }
+                const size_t precision = spec.precision < 0 ? 0 : (size_t)spec.precision;
+                field(out, spec, prefix, prefixLen, precision > len ? precision - len : 0, body, len, spec.precision < 0);
+            }
+
+            inline void writeFloat(Output& out, const Spec& spec, double value) {
+                char prefix[1] = {};
+                size_t prefixLen = 0;
+                if (std::signbit(value)) {
+                    prefix[prefixLen++] = '-';
+                    value = -value;
+                } else if (spec.plus || spec.space) {
+                    prefix[prefixLen++] = spec.plus ? '+' : ' ';
+                }
+                if (!std::isfinite(value)) {
+                    field(out, spec, prefix, prefixLen, 0, std::isnan(value) ? "nan" : "inf", 3, false);
+                    return;
+                }
+
+                const size_t precision = (size_t)(spec.precision < 0 ? 6 : spec.precision < MAX_PRECISION ? spec.precision : MAX_PRECISION);
+                const uint64_t scale = POWERS_OF_TEN[precision];
+
+                // Digits past what fits a uint64_t are written as zeros, so huge values keep their magnitude
+                size_t exponent = 0;
+                while (value >= 1e19) {
+                    value /= 10;
+                    exponent++;
+                }
+                uint64_t whole = (uint64_t)value;
+                const double scaled = (value - (double)whole) * (double)scale;
+                uint64_t fraction = (uint64_t)scaled;
+                const double rest = scaled - (double)fraction;
+                // scaled is rounded, so a rest of one half is settled by the exact residual of the product (scale is
+                //  exactly representable). Only true halves round to even, like printf
+                const double residual = std::fma(value - (double)whole, (double)scale, -scaled);
+                const bool odd = (precision ? fraction : whole) & 1;
+                if (rest > 0.5 || (rest == 0.5 && (residual > 0 || (residual == 0 && odd)))) {
+                    fraction++;
+                }
+                if (fraction >= scale) {
+                    whole++;
+                    fraction -= scale;
+                }
+
+                char wholeDigits[MAX_INTEGER_SIZE];
+                char fractionDigits[MAX_INTEGER_SIZE];
+                const size_t wholeLen = writeDecimal(whole, wholeDigits);
+                const size_t fractionLen = precision > 0 ? writeDecimal(fraction, fractionDigits) : 0;
+                const bool point = precision > 0 || spec.alternate;
+
+                const size_t len = prefixLen + wholeLen + exponent + point + precision;
+                size_t pad = spec.width > len ? spec.width - len : 0;
+                size_t zeros = 0;
+                if (spec.zero && !spec.left) {
+                    zeros = pad;
+                    pad = 0;
+                }
+                if (!spec.left) out.fill(' ', pad);
+                out.put(prefix, prefixLen);
+                out.fill('0', zeros);
+                out.put(wholeDigits, wholeLen);
+                out.fill('0', exponent);
+                if (point) out.put(".", 1);
+                out.fill('0', precision - fractionLen);
+                out.put(fractionDigits, fractionLen);
+                if (spec.left) out.fill(' ', pad);
+            }
+
+            inline void writeString(Output& out, const Spec& spec, const char* str) {
+                if (!str) {
+                    str = "(null)";
+                }
+                size_t len = 0;
+                while (str[len] && (spec.precision < 0 || len < (size_t)spec.precision)) {
+                    len++;
+                }
+                field(out, spec, nullptr, 0, 0, str, len, false);
+            }
+
+            inline void writePointer(Output& out, const Spec& spec, const void* p) {
+                char body[MAX_INTEGER_SIZE];
+                const size_t len = writeHex((uint64_t)reinterpret_cast<uintptr_t>(p), body);
+                field(out, spec, "0x", 2, 0, body, len, false);
+            }
+
+            /**
+             * @brief Format count type erased arguments. Arguments are written as the type they hold even when the
+             *         conversion disagrees, and conversions without an argument are copied through verbatim.
+             */
+            inline size_t write(char* dst, size_t capacity, const char* fmt, const Arg* args, size_t count) {
+                Output out(dst, capacity);
+                size_t next = 0;
+                while (*fmt) {
+                    const char* percent = fmt;
+                    while (*percent && *percent != '%') {
+                        percent++;
+                    }
+                    out.put(fmt, (size_t)(percent - fmt));
+                    if (!*percent) {
+                        break;
+                    }
+
+                    size_t i = 0;
+                    Spec spec{};
+                    const bool supported = parseSpec(percent, i, spec);
+                    fmt = percent + i;
+                    if (supported && spec.conversion == '%') {
+                        out.put("%", 1);
+                        continue;
+                    }
+                    if (!supported || next >= count) {
+                        out.put(percent, i);
+                        continue;
+                    }
+
+                    const Arg& arg = args[next++];
+                    switch (arg.kind) {
+                        case ARG_SIGNED:
+                        case ARG_UNSIGNED:
+                            writeInteger(out, spec, arg);
+                            break;
+                        case ARG_FLOAT:
+                            writeFloat(out, spec, arg.f);
+                            break;
+                        case ARG_STRING:
+                            if (spec.conversion == 'p') {
+                                writePointer(out, spec, arg.s);
+                            } else {
+                                writeString(out, spec, arg.s);
+                            }
+                            break;
+                        case ARG_POINTER:
+                            writePointer(out, spec, arg.p);
+                            break;
+                        case ARG_NONE:
+                            break;
+                    }
+                }
+                return out.size();
+            }
+        }
+
+        /**
+         * @brief Format args into out under fmt, like snprintf but type safe and without a terminator.
+         *
+         * @return How long the whole output is, which may exceed capacity: only the first capacity characters are
+         *          written.
+         */
+        template<typename... Args>
+        inline size_t write(char* out, size_t capacity, const char* fmt, const Args&... args) {
+            const Detail::Arg packed[] = {Detail::toArg(args)..., Detail::Arg{}};
+            return Detail::write(out, capacity, fmt, packed, sizeof...(Args));
+        }
+    }
+}
+
+/**
+ * @brief Check a (literal) format string against the arguments of a call at compile time. The arguments are not
+ *         evaluated.
+ */
+#define META_CHECK_FORMAT(fmt, ...) \
+    ((void)std::integral_constant<bool, Meta::Format::check(decltype(Meta::Format::Detail::argTypes(__VA_ARGS__)){}, fmt)>{})
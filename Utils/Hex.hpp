@@ -0,0 +1,108 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace Meta {
+    namespace Hex {
+        /**
+         * @brief How many bytes a hex dump line shows.
+         */
+        static constexpr size_t BYTES_PER_LINE = 16;
+
+        /**
+         * @brief The size of a full hex dump line: "XX " per byte, an extra space after the eighth, then "\n\r".
+         */
+        static constexpr size_t LINE_SIZE = BYTES_PER_LINE * 3 + 1 + 2;
+
+        static constexpr std::array<char, 512> makePairs() {
+            constexpr char digits[] = "0123456789ABCDEF";
+            std::array<char, 512> pairs = {};
+            for (size_t i = 0; i < 256; i++) {
+                pairs[2 * i] = digits[i >> 4];
+                pairs[2 * i + 1] = digits[i & 0x0F];
+            }
+            return pairs;
+        }
+
+        /**
+         * @brief The two hex characters of every byte value, generated at compile time.
+         */
+        static constexpr std::array<char, 512> PAIRS = makePairs();
+
+        /**
+         * @brief Encode len bytes as 2 * len upper case hex characters (not null terminated).
+         */
+        inline void encode(const uint8_t* in, size_t len, char* out) {
+            size_t i = 0;
+#if defined(__SSE2__)
+            const __m128i nibble = _mm_set1_epi8(0x0F);
+            const __m128i nine = _mm_set1_epi8(9);
+            const __m128i zero = _mm_set1_epi8('0');
+            const __m128i letterGap = _mm_set1_epi8('A' - '0' - 10);
+            for (; i + 16 <= len; i += 16) {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+                __m128i hi = _mm_and_si128(_mm_srli_epi16(v, 4), nibble);
+                __m128i lo = _mm_and_si128(v, nibble);
+                hi = _mm_add_epi8(_mm_add_epi8(hi, zero), _mm_and_si128(_mm_cmpgt_epi8(hi, nine), letterGap));
+                lo = _mm_add_epi8(_mm_add_epi8(lo, zero), _mm_and_si128(_mm_cmpgt_epi8(lo, nine), letterGap));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i), _mm_unpacklo_epi8(hi, lo));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i + 16), _mm_unpackhi_epi8(hi, lo));
+            }
+#elif defined(__ARM_NEON)
+            const uint8x16_t nibble = vdupq_n_u8(0x0F);
+            const uint8x16_t nine = vdupq_n_u8(9);
+            const uint8x16_t zero = vdupq_n_u8('0');
+            const uint8x16_t letterGap = vdupq_n_u8('A' - '0' - 10);
+            for (; i + 16 <= len; i += 16) {
+                const uint8x16_t v = vld1q_u8(in + i);
+                uint8x16x2_t chars;
+                chars.val[0] = vshrq_n_u8(v, 4);
+                chars.val[1] = vandq_u8(v, nibble);
+                chars.val[0] = vaddq_u8(vaddq_u8(chars.val[0], zero), vandq_u8(vcgtq_u8(chars.val[0], nine), letterGap));
+                chars.val[1] = vaddq_u8(vaddq_u8(chars.val[1], zero), vandq_u8(vcgtq_u8(chars.val[1], nine), letterGap));
+                vst2q_u8(reinterpret_cast<uint8_t*>(out + 2 * i), chars);
+            }
+#endif
+            for (; i < len; i++) {
+                memcpy(out + 2 * i, &PAIRS[2 * in[i]], 2);
+            }
+        }
+
+        /**
+         * @brief Format up to BYTES_PER_LINE bytes as a single hex dump line.
+         *
+         * @param out Must hold at least LINE_SIZE characters. The line is not null terminated.
+         * @return How many characters were written.
+         */
+        inline size_t dumpLine(const uint8_t* in, size_t len, char* out) {
+            if (len > BYTES_PER_LINE) {
+                len = BYTES_PER_LINE;
+            }
+
+            char hex[2 * BYTES_PER_LINE];
+            encode(in, len, hex);
+
+            size_t o = 0;
+            for (size_t i = 0; i < len; i++) {
+                out[o++] = hex[2 * i];
+                out[o++] = hex[2 * i + 1];
+                out[o++] = ' ';
+                if (i == 7) {
+                    out[o++] = ' ';
+                }
+            }
+            out[o++] = '\n';
+            out[o++] = '\r';
+            return o;
+        }
+    }
+}
@@ -0,0 +1,235 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include "AbstractLock.hpp"
+
+#if !defined(META_NO_MUTEX)
+#include <mutex>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief The most pause instructions a SpinLock waits between attempts once its backoff has grown.
+ */
+#ifndef META_SPIN_MAX_BACKOFF
+#define META_SPIN_MAX_BACKOFF 64
+#endif
+
+namespace Meta {
+    using AbstractLock = Harbor::AbstractLock;
+
+    /**
+     * @brief Hint to the core that it is spinning, to save power and yield to a sibling hardware thread.
+     */
+    inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+        _mm_pause();
+#elif defined(__aarch64__) || (defined(__ARM_ARCH) && __ARM_ARCH >= 7)
+        __asm__ volatile("yield");
+#endif
+    }
+
+    /**
+     * @brief A lock that does nothing, for policies on single threaded builds. Compiles away entirely.
+     */
+    class NullLock {
+    public:
+        constexpr NullLock() {}
+
+        void lock() {}
+        void unlock() {}
+
+        bool try_lock() {
+            return true;
+        }
+    };
+
+    /**
+     * @brief A test-and-test-and-set spinlock with exponential backoff. Waiters spin on a plain load, so the lock's
+     *         cache line is only written when it looks free.
+     *
+     * Never take it from an interrupt that may preempt its holder on the same core; use InterruptLock there.
+     */
+    class SpinLock {
+    private:
+        std::atomic<bool> locked;
+
+    public:
+        constexpr SpinLock() : locked(false) {}
+
+        SpinLock(const SpinLock& other) = delete;
+        SpinLock& operator=(const SpinLock& other) = delete;
+
+        void lock() {
+            uint32_t backoff = 1;
+            while (locked.exchange(true, std::memory_order_acquire)) {
+                while (locked.load(std::memory_order_relaxed)) {
+                    for (uint32_t i = 0; i < backoff; i++) {
+                        cpuRelax();
+                    }
+                    if (backoff < META_SPIN_MAX_BACKOFF) {
+                        backoff <<= 1;
+                    }
+                }
+            }
+        }
+
+        bool try_lock() {
+            return !locked.load(std::memory_order_relaxed) && !locked.exchange(true, std::memory_order_acquire);
+        }
+
+        void unlock() {
+            locked.store(false, std::memory_order_release);
+        }
+    };
+
+#if defined(__ARM_ARCH_6M__) || defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || \
+    defined(__ARM_ARCH_8M_BASE__) || defined(__ARM_ARCH_8M_MAIN__)
+    /**
+     * @brief Masks interrupts (PRIMASK) while held, making a critical section safe against every ISR on a single core
+     *         Cortex-M. Locking is reentrant: the mask found by the outermost lock() is restored by the matching
+     *         unlock(), so nested critical sections stay masked and a section entered with interrupts already masked
+     *         leaves them masked.
+     */
+    class InterruptLock {
+    private:
+        uint32_t primask; // The mask to restore when the outermost lock is released
+        uint32_t depth; // How many times the lock is currently held, only touched with interrupts masked
+
+    public:
+        constexpr InterruptLock() : primask(0), depth(0) {}
+
+        InterruptLock(const InterruptLock& other) = delete;
+        InterruptLock& operator=(const InterruptLock& other) = delete;
+
+        void lock() {
+            uint32_t mask;
+            __asm__ volatile("mrs %0, primask" : "=r"(mask));
+            __asm__ volatile("cpsid i" ::: "memory");
+            if (depth++ == 0) {
+                primask = mask;
+            }
+        }
+
+        bool try_lock() {
+            lock();
+            return true;
+        }
+
+        void unlock() {
+            if (--depth == 0) {
+                __asm__ volatile("msr primask, %0" :: "r"(primask) : "memory");
+            }
+        }
+    };
+#endif
+
+#if !defined(META_NO_MUTEX)
+    /**
+     * @brief A std::mutex behind the lock policy interface, for hosted builds where waiters should sleep.
+     */
+    class MutexLock {
+    private:
+        std::mutex mutex;
+
+    public:
+        constexpr MutexLock() noexcept {}
+
+        void lock() {
+            mutex.lock();
+        }
+
+        bool try_lock() {
+            return mutex.try_lock();
+        }
+
+        void unlock() {
+            mutex.unlock();
+        }
+    };
+#endif
+
+    /**
+     * @brief Any lock policy behind the virtual AbstractLock interface, for code that picks its lock at runtime.
+     */
+    template<typename Lock>
+    class VirtualLock : public AbstractLock {
+    private:
+        Lock impl;
+
+    public:
+        constexpr VirtualLock() : impl() {}
+
+        void lock() override {
+            impl.lock();
+        }
+
+        void unlock() override {
+            impl.unlock();
+        }
+    };
+
+    /**
+     * @brief Holds a lock for its own lifetime. Works with every lock here as well as AbstractLock.
+     */
+    template<typename Lock>
+    class LockGuard {
+    private:
+        Lock& held;
+
+    public:
+        explicit LockGuard(Lock& lock) : held(lock) {
+            held.lock();
+        }
+
+        LockGuard(const LockGuard& other) = delete;
+        LockGuard& operator=(const LockGuard& other) = delete;
+
+        ~LockGuard() {
+            held.unlock();
+        }
+    };
+
+    /**
+     * @brief A value (e.g. a Buffer or StaticMap) that can only be reached while its lock is held.
+     *
+     * @tparam T The guarded type.
+     * @tparam Lock The lock policy. NullLock makes every access a plain call.
+     */
+    template<typename T, typename Lock = SpinLock>
+    class Guarded {
+    private:
+        T value;
+        mutable Lock mutex;
+
+    public:
+        template<typename... Args>
+        explicit Guarded(Args&&... args) : value(std::forward<Args>(args)...), mutex() {}
+
+        Guarded(const Guarded& other) = delete;
+        Guarded& operator=(const Guarded& other) = delete;
+
+        /**
+         * @brief Call f with the value while holding the lock.
+         *
+         * @return Whatever f returns. It must not hold on to the reference.
+         */
+        template<typename F>
+        decltype(auto) with(F&& f) {
+            LockGuard<Lock> guard(mutex);
+            return std::forward<F>(f)(value);
+        }
+
+        template<typename F>
+        decltype(auto) with(F&& f) const {
+            LockGuard<Lock> guard(mutex);
+            return std::forward<F>(f)(static_cast<const T&>(value));
+        }
+    };
+}
@@ -0,0 +1,229 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "../Errors/ErrorUnion.hpp"
+#include "../Errors/Errors.hpp"
+#include "../Structures/Buffer.hpp"
+#include "../Structures/BufferView.hpp"
+#include "ArrayUtils.hpp"
+#include "Constexpr.hpp"
+#include "Endian.hpp"
+#include "Fields.hpp"
+
+namespace Meta {
+    /**
+     * @brief How a struct is laid out on the wire. Specialize it for each serialized struct, deriving from its
+     *         Fields in wire order:
+     *
+     *   template<> struct Meta::SerialLayout<Header> : Meta::Fields<&Header::type, &Header::length> {};
+     *
+     * Fields may be arithmetic values, enums, (std::) arrays of those, or structs with a SerialLayout of their own.
+     *  Members left out of the list are not serialized, and decoded structs get them value initialized.
+     */
+    template<typename S>
+    struct SerialLayout {};
+
+    template<typename S, Endian E>
+    class Serializer;
+
+    namespace Detail {
+        template<auto... Members>
+        std::true_type isFields(const Fields<Members...>*);
+        std::false_type isFields(const void*);
+
+        template<typename S>
+        using HasSerialLayout = decltype(isFields(static_cast<const SerialLayout<S>*>(nullptr)));
+
+        /**
+         * @brief How a single field of type T is written and read.
+         */
+        template<typename T, Endian E, typename Enable = void>
+        struct SerialCodec {
+            static_assert(sizeof(T) == 0, "Fields must be arithmetic, enums, arrays of those or structs with a SerialLayout.");
+        };
+
+        template<typename T, Endian E>
+        struct SerialCodec<T, E, typename std::enable_if<std::is_arithmetic<T>::value || std::is_enum<T>::value>::type> {
+            static constexpr size_t SIZE = sizeof(T);
+
+            static META_CONSTEXPR20 void store(const T& t, uint8_t* out) {
+                storeBytes<T, E>(t, out);
+            }
+
+            static META_CONSTEXPR20 void load(const uint8_t* in, T& t) {
+                t = loadBytes<T, E>(in);
+            }
+        };
+
+        template<typename T, Endian E>
+        struct SerialCodec<T, E, typename std::enable_if<HasSerialLayout<T>::value>::type> {
+            static constexpr size_t SIZE = Serializer<T, E>::SIZE;
+
+            static META_CONSTEXPR20 void store(const T& t, uint8_t* out) {
+                Serializer<T, E>::encode(t, out);
+            }
+
+            static META_CONSTEXPR20 void load(const uint8_t* in, T& t) {
+                Serializer<T, E>::decode(in, t);
+            }
+        };
+
+        /**
+         * @brief Arrays of numbers go as one bulk copy or byte swap, arrays of structs element by element.
+         */
+        template<typename T, size_t N, Endian E>
+        struct SerialArrayCodec {
+            typedef SerialCodec<T, E> Element;
+            static constexpr bool BULK = std::is_arithmetic<T>::value || std::is_enum<T>::value;
+            static constexpr size_t SIZE = N * Element::SIZE;
+
+            static META_CONSTEXPR20 void store(const T* arr, uint8_t* out) {
+                if constexpr (BULK) {
+                    storeBytes<T, E>(arr, N, out);
+                } else {
+                    for (size_t i = 0; i < N; i++) {
+                        Element::store(arr[i], out + i * Element::SIZE);
+                    }
+                }
+            }
+
+            static META_CONSTEXPR20 void load(const uint8_t* in, T* arr) {
+                if constexpr (BULK) {
+                    loadBytes<T, E>(in, N, arr);
+                } else {
+                    for (size_t i = 0; i < N; i++) {
+                        Element::load(in + i * Element::SIZE, arr[i]);
+                    }
+                }
+            }
+        };
+
+        template<typename T, size_t N, Endian E>
+        struct SerialCodec<T[N], E> : SerialArrayCodec<T, N, E> {};
+
+        template<typename T, size_t N, Endian E>
+        struct SerialCodec<std::array<T, N>, E> : SerialArrayCodec<T, N, E> {
+            static META_CONSTEXPR20 void store(const std::array<T, N>& arr, uint8_t* out) {
+                SerialArrayCodec<T, N, E>::store(arr.data(), out);
+            }
+
+            static META_CONSTEXPR20 void load(const uint8_t* in, std::array<T, N>& arr) {
+                SerialArrayCodec<T, N, E>::load(in, arr.data());
+            }
+        };
+
+        template<auto Member, Endian E>
+        using FieldCodec = SerialCodec<typename MemberPointer<decltype(Member)>::Type, E>;
+
+        /**
+         * @brief A whole field list: its wire size and the (unchecked) field by field copies.
+         */
+        template<Endian E, auto... Members>
+        struct SerialFields {
+            static_assert(sizeof...(Members) > 0, "A SerialLayout needs at least one field.");
+
+            static constexpr size_t SIZE = (size_t(0) + ... + FieldCodec<Members, E>::SIZE);
+
+            template<typename S>
+            static constexpr bool BELONG_TO = (std::is_base_of<typename MemberPointer<decltype(Members)>::Struct, S>::value && ...);
+
+            template<typename S>
+            static META_CONSTEXPR20 void store(const S& s, uint8_t* out) {
+                size_t offset = 0;
+                ((FieldCodec<Members, E>::store(s.*Members, out + offset), offset += FieldCodec<Members, E>::SIZE), ...);
+            }
+
+            template<typename S>
+            static META_CONSTEXPR20 void load(const uint8_t* in, S& s) {
+                size_t offset = 0;
+                ((FieldCodec<Members, E>::load(in + offset, s.*Members), offset += FieldCodec<Members, E>::SIZE), ...);
+            }
+        };
+
+        template<Endian E, auto... Members>
+        SerialFields<E, Members...> serialFieldsOf(const Fields<Members...>*);
+    }
+
+    /**
+     * @brief Packs structs into and out of byte streams, field by field in their SerialLayout's order with no
+     *         padding, in a fixed wire byte order.
+     *
+     * The layout is resolved at compile time: SIZE is a constant, unsupported field types fail to compile, and
+     *  encoding and decoding are straight line copies. Buffers and views are bounds checked once per message, never
+     *  per field. Nothing logs beyond the Buffer it encodes into.
+     *
+     * @tparam S The struct, with a SerialLayout specialization.
+     * @tparam E The byte order every field is written in.
+     */
+    template<typename S, Endian E = Endian::Little>
+    class Serializer {
+        static_assert(Detail::HasSerialLayout<S>::value,
+                      "Serialized structs need a SerialLayout specialization deriving from their Fields.");
+
+    private:
+        typedef decltype(Detail::serialFieldsOf<E>(static_cast<const SerialLayout<S>*>(nullptr))) Layout;
+
+        static_assert(Layout::template BELONG_TO<S>, "Every field in a SerialLayout must be a member of its struct.");
+
+    public:
+        /**
+         * @brief The size of an encoded S in bytes.
+         */
+        static constexpr size_t SIZE = Layout::SIZE;
+
+        /**
+         * @brief Encode s into out, which must hold at least SIZE bytes.
+         */
+        static META_CONSTEXPR20 void encode(const S& s, uint8_t* out) {
+            Layout::store(s, out);
+        }
+
+        /**
+         * @brief Encode s into a buffer of exactly SIZE bytes.
+         */
+        static META_CONSTEXPR20 Buffer<uint8_t, SIZE> encode(const S& s) {
+            auto bytes = Buffer<uint8_t, SIZE>::uninitialized();
+            encode(s, bytes.extend(SIZE).value());
+            return bytes;
+        }
+
+        /**
+         * @brief Append s to the end of buf.
+         *
+         * @return An error if buf cannot hold another SIZE bytes, void otherwise.
+         */
+        template<size_t C, size_t A>
+        static META_CONSTEXPR20 ErrorUnion<void> encode(const S& s, Buffer<uint8_t, C, A>& buf) {
+            return buf.extend(SIZE).transform([&s](uint8_t* out) { encode(s, out); });
+        }
+
+        /**
+         * @brief Decode the SIZE bytes at in into s. Members not in the layout are left untouched.
+         */
+        static META_CONSTEXPR20 void decode(const uint8_t* in, S& s) {
+            Layout::load(in, s);
+        }
+
+        /**
+         * @brief Decode the S at the start of bytes. Any bytes past the first SIZE are ignored.
+         *
+         * @return An error if bytes is shorter than SIZE, the decoded S otherwise.
+         */
+        static META_CONSTEXPR20 ErrorUnion<S> decode(const BufferView<uint8_t>& bytes) {
+            if (bytes.size() < SIZE) {
+                return ErrorUnion<S>(MAKE_ERROR(BUFFER_ERROR_OUT_OF_BOUNDS, "Message truncated"));
+            }
+            S s{};
+            decode(bytes.cArr(), s);
+            return ErrorUnion<S>(std::move(s));
+        }
+
+        template<size_t C, size_t A>
+        static META_CONSTEXPR20 ErrorUnion<S> decode(const Buffer<uint8_t, C, A>& buf) {
+            return decode(buf.view());
+        }
+    };
+}
@@ -0,0 +1,352 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+/**
+ * @brief Set to 1 to search bytes with the kernels below rather than memchr, e.g. on embedded targets whose libc
+ *         memchr is a plain byte loop. Hosted libcs ship memchr tuned (and dispatched at runtime) for the running CPU,
+ *         which the kernels cannot beat.
+ */
+#ifndef META_SIMD_INLINE_MEMCHR
+#define META_SIMD_INLINE_MEMCHR 0
+#endif
+
+namespace Meta {
+    namespace Simd {
+        /**
+         * @brief Whether the kernels below compare Ts a vector at a time: bytes and 2/4 byte integers (and enums)
+         *         whose equality is bitwise. Everything else falls back to element-wise loops.
+         */
+        template<typename T>
+        static constexpr bool VECTORIZED = (std::is_integral<T>::value || std::is_enum<T>::value) &&
+                                           (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4);
+
+        /**
+         * @brief How many needles findAny() compares per vector before falling back to element-wise search.
+         */
+        static constexpr size_t MAX_VECTOR_NEEDLES = 8;
+
+        namespace Detail {
+            inline size_t countTrailingZeros(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+                return (size_t)__builtin_ctzll(x);
+#else
+                size_t n = 0;
+                while (!(x & 1)) {
+                    x >>= 1;
+                    n++;
+                }
+                return n;
+#endif
+            }
+
+            template<size_t Size>
+            using Word = typename std::conditional<Size == 1, uint8_t,
+                         typename std::conditional<Size == 2, uint16_t, uint32_t>::type>::type;
+
+            template<typename T>
+            inline Word<sizeof(T)> bitsOf(const T& t) {
+                Word<sizeof(T)> w;
+                memcpy(&w, &t, sizeof(T));
+                return w;
+            }
+
+            /*
+             * Per ISA: splat(w) fills a vector with one element, compare<Size>(a, b) compares Size byte lanes, and
+             *  bitmask(eq) turns a comparison into BITS_PER_BYTE bits per byte, lowest address first.
+             */
+#if defined(__AVX2__)
+            static constexpr size_t VECTOR_SIZE = 32;
+            static constexpr size_t BITS_PER_BYTE = 1;
+            typedef __m256i Vector;
+
+            template<size_t Size>
+            inline Vector splat(Word<Size> w) {
+                if constexpr (Size == 1) {
+                    return _mm256_set1_epi8((char)w);
+                } else if constexpr (Size == 2) {
+                    return _mm256_set1_epi16((short)w);
+                } else {
+                    return _mm256_set1_epi32((int)w);
+                }
+            }
+
+            inline Vector load(const uint8_t* p) {
+                return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+            }
+
+            template<size_t Size>
+            inline Vector compare(Vector a, Vector b) {
+                if constexpr (Size == 1) {
+                    return _mm256_cmpeq_epi8(a, b);
+                } else if constexpr (Size == 2) {
+                    return _mm256_cmpeq_epi16(a, b);
+                } else {
+                    return _mm256_cmpeq_epi32(a, b);
+                }
+            }
+
+            inline Vector either(Vector a, Vector b) {
+                return _mm256_or_si256(a, b);
+            }
+
+            inline uint64_t bitmask(Vector eq) {
+                return (uint32_t)_mm256_movemask_epi8(eq);
+            }
+#elif defined(__SSE2__)
+            static constexpr size_t VECTOR_SIZE = 16;
+            static constexpr size_t BITS_PER_BYTE = 1;
+            typedef __m128i Vector;
+
+            template<size_t Size>
+            inline Vector splat(Word<Size> w) {
+                if constexpr (Size == 1) {
+                    return _mm_set1_epi8((char)w);
+                } else if constexpr (Size == 2) {
+                    return _mm_set1_epi16((short)w);
+                } else {
+                    return _mm_set1_epi32((int)w);
+                }
+            }
+
+            inline Vector load(const uint8_t* p) {
+                return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+            }
+
+            template<size_t Size>
+            inline Vector compare(Vector a, Vector b) {
+                if constexpr (Size == 1) {
+                    return _mm_cmpeq_epi8(a, b);
+                } else if constexpr (Size == 2) {
+                    return _mm_cmpeq_epi16(a, b);
+                } else {
+                    return _mm_cmpeq_epi32(a, b);
+                }
+            }
+
+            inline Vector either(Vector a, Vector b) {
+                return _mm_or_si128(a, b);
+            }
+
+            inline uint64_t bitmask(Vector eq) {
+                return (uint32_t)_mm_movemask_epi8(eq);
+            }
+#elif defined(__ARM_NEON)
+            static constexpr size_t VECTOR_SIZE = 16;
+            static constexpr size_t BITS_PER_BYTE = 4;
+            typedef uint8x16_t Vector;
+
+            template<size_t Size>
+            inline Vector splat(Word<Size> w) {
+                if constexpr (Size == 1) {
+                    return vdupq_n_u8(w);
+                } else if constexpr (Size == 2) {
+                    return vreinterpretq_u8_u16(vdupq_n_u16(w));
+                } else {
+                    return vreinterpretq_u8_u32(vdupq_n_u32(w));
+                }
+            }
+
+            inline Vector load(const uint8_t* p) {
+                return vld1q_u8(p);
+            }
+
+            template<size_t Size>
+            inline Vector compare(Vector a, Vector b) {
+                if constexpr (Size == 1) {
+                    return vceqq_u8(a, b);
+                } else if constexpr (Size == 2) {
+                    return vreinterpretq_u8_u16(vceqq_u16(vreinterpretq_u16_u8(a), vreinterpretq_u16_u8(b)));
+                } else {
+                    return vreinterpretq_u8_u32(vceqq_u32(vreinterpretq_u32_u8(a), vreinterpretq_u32_u8(b)));
+                }
+            }
+
+            inline Vector either(Vector a, Vector b) {
+                return vorrq_u8(a, b);
+            }
+
+            // NEON has no movemask: narrowing each 16 bit lane by 4 leaves a nibble per byte
+            inline uint64_t bitmask(Vector eq) {
+                return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(eq), 4)), 0);
+            }
+#endif
+
+            /**
+             * @brief Find a byte a machine word at a time, for targets without vector units.
+             */
+            inline size_t findByteSwar(const uint8_t* p, size_t n, uint8_t value) {
+                typedef uint32_t Block;
+                constexpr Block ones = (Block)0x01010101u;
+                constexpr Block highs = (Block)0x80808080u;
+                const Block pattern = ones * value;
+                size_t i = 0;
+                for (; i + sizeof(Block) <= n; i += sizeof(Block)) {
+                    Block x;
+                    memcpy(&x, p + i, sizeof(Block));
+                    x ^= pattern;
+                    // Non-zero exactly when one of the bytes of x is zero, i.e. matched
+                    if ((x - ones) & ~x & highs) {
+                        break;
+                    }
+                }
+                for (; i < n; i++) {
+                    if (p[i] == value) {
+                        return i;
+                    }
+                }
+                return n;
+            }
+        }
+
+        /**
+         * @brief The index of the first of n Ts equal to value, or n if there is none. Bytes go through memchr unless
+         *         META_SIMD_INLINE_MEMCHR is set.
+         */
+        template<typename T>
+        inline size_t find(const T* arr, size_t n, const T& value) {
+            size_t i = 0;
+            if constexpr (VECTORIZED<T>) {
+#if !META_SIMD_INLINE_MEMCHR
+                if constexpr (sizeof(T) == 1) {
+                    const void* hit = memchr(arr, Detail::bitsOf(value), n);
+                    return hit ? (size_t)(static_cast<const T*>(hit) - arr) : n;
+                }
+#endif
+#if defined(__AVX2__) || defined(__SSE2__) || defined(__ARM_NEON)
+                using namespace Detail;
+                constexpr size_t lanes = VECTOR_SIZE / sizeof(T);
+                const uint8_t* bytes = reinterpret_cast<const uint8_t*>(arr);
+                const Vector needle = splat<sizeof(T)>(bitsOf(value));
+                // Four vectors per iteration share one branch, so the loop is bound by loads rather than by the
+                //  compare-movemask-branch chain of each vector
+                for (; i + 4 * lanes <= n; i += 4 * lanes) {
+                    const uint8_t* p = bytes + i * sizeof(T);
+                    const Vector eq0 = compare<sizeof(T)>(load(p), needle);
+                    const Vector eq1 = compare<sizeof(T)>(load(p + VECTOR_SIZE), needle);
+                    const Vector eq2 = compare<sizeof(T)>(load(p + 2 * VECTOR_SIZE), needle);
+                    const Vector eq3 = compare<sizeof(T)>(load(p + 3 * VECTOR_SIZE), needle);
+                    if (bitmask(either(either(eq0, eq1), either(eq2, eq3)))) {
+                        break;
+                    }
+                }
+                for (; i + lanes <= n; i += lanes) {
+                    const uint64_t hits = bitmask(compare<sizeof(T)>(load(bytes + i * sizeof(T)), needle));
+                    if (hits) {
+                        return i + countTrailingZeros(hits) / BITS_PER_BYTE / sizeof(T);
+                    }
+                }
+#else
+                if constexpr (sizeof(T) == 1) {
+                    return Detail::findByteSwar(reinterpret_cast<const uint8_t*>(arr), n, (uint8_t)value);
+                }
+#endif
+            }
+            for (; i < n; i++) {
+                if (arr[i] == value) {
+                    return i;
+                }
+            }
+            return n;
+        }
+
+        /**
+         * @brief The index of the first of n Ts equal to any of the setLen needles, or n if there is none.
+         */
+        template<typename T>
+        inline size_t findAny(const T* arr, size_t n, const T* set, size_t setLen) {
+            if (setLen == 0) {
+                return n;
+            }
+            if (setLen == 1) {
+                return find(arr, n, set[0]);
+            }
+            size_t i = 0;
+            if constexpr (VECTORIZED<T>) {
+#if defined(__AVX2__) || defined(__SSE2__) || defined(__ARM_NEON)
+                using namespace Detail;
+                if (setLen <= MAX_VECTOR_NEEDLES) {
+                    constexpr size_t lanes = VECTOR_SIZE / sizeof(T);
+                    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(arr);
+                    Vector needles[MAX_VECTOR_NEEDLES];
+                    for (size_t k = 0; k < setLen; k++) {
+                        needles[k] = splat<sizeof(T)>(bitsOf(set[k]));
+                    }
+                    for (; i + lanes <= n; i += lanes) {
+                        const Vector v = load(bytes + i * sizeof(T));
+                        Vector eq = compare<sizeof(T)>(v, needles[0]);
+                        for (size_t k = 1; k < setLen; k++) {
+                            eq = either(eq, compare<sizeof(T)>(v, needles[k]));
+                        }
+                        const uint64_t hits = bitmask(eq);
+                        if (hits) {
+                            return i + countTrailingZeros(hits) / BITS_PER_BYTE / sizeof(T);
+                        }
+                    }
+                }
+#endif
+                if constexpr (sizeof(T) == 1) {
+                    // One bit per byte value, so each remaining byte costs a single lookup
+                    uint32_t members[8] = {};
+                    for (size_t k = 0; k < setLen; k++) {
+                        const uint8_t b = (uint8_t)set[k];
+                        members[b >> 5] |= 1u << (b & 31);
+                    }
+                    for (; i < n; i++) {
+                        const uint8_t b = (uint8_t)arr[i];
+                        if (members[b >> 5] & (1u << (b & 31))) {
+                            return i;
+                        }
+                    }
+                    return n;
+                }
+            }
+            for (; i < n; i++) {
+                for (size_t k = 0; k < setLen; k++) {
+                    if (arr[i] == set[k]) {
+                        return i;
+                    }
+                }
+            }
+            return n;
+        }
+
+        /**
+         * @brief Whether n Ts at a and b are all equal.
+         */
+        template<typename T>
+        inline bool equal(const T* a, const T* b, size_t n) {
+            if constexpr (VECTORIZED<T>) {
+                size_t i = 0;
+#if defined(__AVX2__) || defined(__SSE2__) || defined(__ARM_NEON)
+                using namespace Detail;
+                const uint8_t* x = reinterpret_cast<const uint8_t*>(a);
+                const uint8_t* y = reinterpret_cast<const uint8_t*>(b);
+                const size_t len = n * sizeof(T);
+                constexpr uint64_t all = VECTOR_SIZE * BITS_PER_BYTE == 64 ? ~0ull : (1ull << (VECTOR_SIZE * BITS_PER_BYTE)) - 1;
+                for (; i + VECTOR_SIZE <= len; i += VECTOR_SIZE) {
+                    if (bitmask(compare<1>(load(x + i), load(y + i))) != all) {
+                        return false;
+                    }
+                }
+                i /= sizeof(T);
+#endif
+                return n == i || memcmp(a + i, b + i, (n - i) * sizeof(T)) == 0;
+            } else {
+                return std::equal(a, a + n, b);
+            }
+        }
+    }
+}
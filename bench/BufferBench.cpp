@@ -0,0 +1,384 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "../Structures/Buffer.hpp"
+#include "../Structures/FrameParser.hpp"
+#include "../Structures/RingBuffer.hpp"
+#include "../Structures/SoABuffer.hpp"
+#include "../Utils/Serializer.hpp"
+
+namespace {
+
+struct Sample {
+    uint32_t timestamp;
+    int16_t x, y, z;
+    uint16_t flags;
+};
+
+}
+
+template<>
+struct Meta::SerialLayout<Sample> : Meta::Fields<&Sample::timestamp, &Sample::x, &Sample::y, &Sample::z, &Sample::flags> {};
+
+namespace {
+
+// The filler elements appended from
+template<typename T, size_t C>
+const std::array<T, C>& source() {
+    static const std::array<T, C> arr = {};
+    return arr;
+}
+
+template<typename T, size_t C>
+void BM_BufferAppend(benchmark::State& state) {
+    auto buf = Meta::Buffer<T, C>::uninitialized();
+    const auto& src = source<T, C>();
+    for (auto _ : state) {
+        buf.clear();
+        for (size_t i = 0; i + 8 <= C; i += 8) {
+            benchmark::DoNotOptimize(buf.append(src.data() + i, 8));
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * (C / 8) * 8 * sizeof(T));
+}
+
+template<typename T, size_t C>
+void BM_VectorAppend(benchmark::State& state) {
+    std::vector<T> vec;
+    vec.reserve(C);
+    const auto& src = source<T, C>();
+    for (auto _ : state) {
+        vec.clear();
+        for (size_t i = 0; i + 8 <= C; i += 8) {
+            vec.insert(vec.end(), src.data() + i, src.data() + i + 8);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * (C / 8) * 8 * sizeof(T));
+}
+
+template<typename T, size_t C>
+void BM_BufferPushBack(benchmark::State& state) {
+    auto buf = Meta::Buffer<T, C>::uninitialized();
+    const T t = {};
+    for (auto _ : state) {
+        buf.clear();
+        for (size_t i = 0; i < C; i++) {
+            benchmark::DoNotOptimize(buf.push_back(t));
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * C);
+}
+
+template<typename T, size_t C>
+void BM_VectorPushBack(benchmark::State& state) {
+    std::vector<T> vec;
+    vec.reserve(C);
+    const T t = {};
+    for (auto _ : state) {
+        vec.clear();
+        for (size_t i = 0; i < C; i++) {
+            vec.push_back(t);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * C);
+}
+
+// Drain a full buffer N bytes at a time
+template<size_t C, size_t N>
+void BM_BufferTake(benchmark::State& state) {
+    auto buf = Meta::Buffer<uint8_t, C>::uninitialized();
+    const auto& src = source<uint8_t, C>();
+    for (auto _ : state) {
+        buf.clear();
+        buf.append(src.data(), C);
+        while (buf.size() >= N) {
+            benchmark::DoNotOptimize(buf.template take<N>(N));
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * C);
+}
+
+// The zero-copy equivalent of BM_BufferTake
+template<size_t C, size_t N>
+void BM_SpanTake(benchmark::State& state) {
+    const auto& src = source<uint8_t, C>();
+    for (auto _ : state) {
+        std::span<const uint8_t> span(src);
+        while (span.size() >= N) {
+            auto taken = span.first<N>();
+            benchmark::DoNotOptimize(taken.data());
+            span = span.subspan(N);
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * C);
+}
+
+// Walk a full buffer N bytes at a time through views
+template<size_t C, size_t N>
+void BM_BufferViewTake(benchmark::State& state) {
+    const auto& src = source<uint8_t, C>();
+    for (auto _ : state) {
+        Meta::BufferView<uint8_t> view(src.data(), src.size());
+        while (view.size() >= N) {
+            auto taken = view.first(N);
+            benchmark::DoNotOptimize(taken.cArr());
+            view = view.dropFirst(N);
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * C);
+}
+
+// A read carrying k length-prefixed 16 byte frames, reassembled by append + take
+template<size_t K>
+void BM_BufferReassemble(benchmark::State& state) {
+    std::array<uint8_t, K * 18> read = {};
+    for (size_t i = 0; i < K; i++) {
+        read[i * 18] = 16;
+    }
+    auto buf = Meta::Buffer<uint8_t, K * 18>::uninitialized();
+    for (auto _ : state) {
+        buf.append(read);
+        while (buf.size() >= 2) {
+            auto header = buf.template take<2>(2);
+            benchmark::DoNotOptimize(buf.template take<16>(header[0]));
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * read.size());
+}
+
+// The same reads through FrameParser
+template<size_t K>
+void BM_FrameParserReassemble(benchmark::State& state) {
+    std::array<uint8_t, K * 18> read = {};
+    for (size_t i = 0; i < K; i++) {
+        read[i * 18] = 16;
+    }
+    Meta::FrameParser<K * 18, Meta::LengthPrefixFraming<uint16_t>> parser;
+    for (auto _ : state) {
+        parser.feed(read.data(), read.size());
+        for (auto frame = parser.next(); !frame.hasError(); frame = parser.next()) {
+            benchmark::DoNotOptimize(frame.getValue().cArr());
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * read.size());
+}
+
+template<typename T, size_t C, Meta::Endian E>
+void BM_BufferToBytes(benchmark::State& state) {
+    Meta::Buffer<T, C> buf(source<T, C>());
+    for (auto _ : state) {
+        auto bytes = buf.template toBytes<E>();
+        benchmark::DoNotOptimize(bytes.cArr());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * C * sizeof(T));
+}
+
+// Byte order conversion by hand into a vector, the way toBytes would otherwise be written
+template<typename T, size_t C, Meta::Endian E>
+void BM_VectorToBytes(benchmark::State& state) {
+    const std::vector<T> vec(C);
+    std::vector<uint8_t> bytes(C * sizeof(T));
+    for (auto _ : state) {
+        for (size_t i = 0; i < C; i++) {
+            const T t = Meta::toEndian<E>(vec[i]);
+            memcpy(bytes.data() + i * sizeof(T), &t, sizeof(T));
+        }
+        benchmark::DoNotOptimize(bytes.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * C * sizeof(T));
+}
+
+using SampleSerializer = Meta::Serializer<Sample, Meta::Endian::Big>;
+
+// A stream of big endian Samples decoded with one bounds check per message
+void BM_SerializerDecode(benchmark::State& state) {
+    const auto& wire = source<uint8_t, 64 * SampleSerializer::SIZE>();
+    for (auto _ : state) {
+        Meta::BufferView<uint8_t> rest(wire);
+        while (auto sample = SampleSerializer::decode(rest)) {
+            benchmark::DoNotOptimize(sample.value());
+            rest = rest.dropFirst(SampleSerializer::SIZE);
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * 64 * SampleSerializer::SIZE);
+}
+
+// The same stream decoded by hand, the way take<N>() output would otherwise be picked apart
+void BM_HandDecode(benchmark::State& state) {
+    const auto& wire = source<uint8_t, 64 * SampleSerializer::SIZE>();
+    for (auto _ : state) {
+        for (size_t i = 0; i + SampleSerializer::SIZE <= wire.size(); i += SampleSerializer::SIZE) {
+            const uint8_t* in = wire.data() + i;
+            Sample sample;
+            sample.timestamp = (uint32_t)in[0] << 24 | (uint32_t)in[1] << 16 | (uint32_t)in[2] << 8 | in[3];
+            sample.x = (int16_t)(in[4] << 8 | in[5]);
+            sample.y = (int16_t)(in[6] << 8 | in[7]);
+            sample.z = (int16_t)(in[8] << 8 | in[9]);
+            sample.flags = (uint16_t)(in[10] << 8 | in[11]);
+            benchmark::DoNotOptimize(sample);
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * 64 * SampleSerializer::SIZE);
+}
+
+// A 16 KB buffer whose only delimiter is its last byte
+const Meta::Buffer<uint8_t, 16384>& delimited() {
+    static const Meta::Buffer<uint8_t, 16384> buf = [] {
+        Meta::Buffer<uint8_t, 16384> b(source<uint8_t, 16384>());
+        b[16383] = '\n';
+        return b;
+    }();
+    return buf;
+}
+
+void BM_BufferFind(benchmark::State& state) {
+    const auto& buf = delimited();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(buf.find('\n'));
+    }
+    state.SetBytesProcessed(state.iterations() * buf.size());
+}
+
+// The hand loop find replaces
+void BM_LoopFind(benchmark::State& state) {
+    const auto& buf = delimited();
+    for (auto _ : state) {
+        size_t i = 0;
+        while (i < buf.size() && buf[i] != '\n') {
+            i++;
+        }
+        benchmark::DoNotOptimize(i);
+    }
+    state.SetBytesProcessed(state.iterations() * buf.size());
+}
+
+void BM_BufferFindAny(benchmark::State& state) {
+    const auto& buf = delimited();
+    const std::array<uint8_t, 3> delimiters = {'\r', '\n', 0xFF};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(buf.find_any(delimiters));
+    }
+    state.SetBytesProcessed(state.iterations() * buf.size());
+}
+
+struct IqSample {
+    int16_t i, q;
+    uint32_t ts;
+};
+
+// Signal power over a block of samples, touching only i and q
+void BM_AoSPower(benchmark::State& state) {
+    Meta::Buffer<IqSample, 4096> buf(source<IqSample, 4096>());
+    for (auto _ : state) {
+        int64_t power = 0;
+        for (const IqSample& s : buf) {
+            power += (int32_t)s.i * s.i + (int32_t)s.q * s.q;
+        }
+        benchmark::DoNotOptimize(power);
+    }
+    state.SetItemsProcessed(state.iterations() * 4096);
+}
+
+void BM_SoAPower(benchmark::State& state) {
+    static Meta::SoABuffer<4096, &IqSample::i, &IqSample::q, &IqSample::ts> buf;
+    buf.clear();
+    buf.append(source<IqSample, 4096>().data(), 4096);
+    for (auto _ : state) {
+        const int16_t* i = buf.column<&IqSample::i>();
+        const int16_t* q = buf.column<&IqSample::q>();
+        int64_t power = 0;
+        for (size_t k = 0; k < buf.size(); k++) {
+            power += (int32_t)i[k] * i[k] + (int32_t)q[k] * q[k];
+        }
+        benchmark::DoNotOptimize(power);
+    }
+    state.SetItemsProcessed(state.iterations() * 4096);
+}
+
+template<typename T, size_t C>
+void BM_RingBufferPushPop(benchmark::State& state) {
+    static Meta::RingBuffer<T, C> ring;
+    const T t = {};
+    for (auto _ : state) {
+        for (size_t i = 0; i < C; i++) {
+            benchmark::DoNotOptimize(ring.push(t));
+        }
+        for (size_t i = 0; i < C; i++) {
+            benchmark::DoNotOptimize(ring.pop());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * C * 2);
+}
+
+}
+
+BENCHMARK_TEMPLATE(BM_BufferAppend, uint8_t, 64);
+BENCHMARK_TEMPLATE(BM_BufferAppend, uint8_t, 1024);
+BENCHMARK_TEMPLATE(BM_BufferAppend, uint8_t, 16384);
+BENCHMARK_TEMPLATE(BM_BufferAppend, uint32_t, 64);
+BENCHMARK_TEMPLATE(BM_BufferAppend, uint32_t, 1024);
+BENCHMARK_TEMPLATE(BM_BufferAppend, Sample, 64);
+BENCHMARK_TEMPLATE(BM_BufferAppend, Sample, 1024);
+BENCHMARK_TEMPLATE(BM_VectorAppend, uint8_t, 64);
+BENCHMARK_TEMPLATE(BM_VectorAppend, uint8_t, 1024);
+BENCHMARK_TEMPLATE(BM_VectorAppend, uint8_t, 16384);
+BENCHMARK_TEMPLATE(BM_VectorAppend, uint32_t, 64);
+BENCHMARK_TEMPLATE(BM_VectorAppend, uint32_t, 1024);
+BENCHMARK_TEMPLATE(BM_VectorAppend, Sample, 64);
+BENCHMARK_TEMPLATE(BM_VectorAppend, Sample, 1024);
+
+BENCHMARK_TEMPLATE(BM_BufferPushBack, uint8_t, 1024);
+BENCHMARK_TEMPLATE(BM_BufferPushBack, uint32_t, 1024);
+BENCHMARK_TEMPLATE(BM_BufferPushBack, Sample, 1024);
+BENCHMARK_TEMPLATE(BM_VectorPushBack, uint8_t, 1024);
+BENCHMARK_TEMPLATE(BM_VectorPushBack, uint32_t, 1024);
+BENCHMARK_TEMPLATE(BM_VectorPushBack, Sample, 1024);
+
+BENCHMARK_TEMPLATE(BM_BufferTake, 64, 8);
+BENCHMARK_TEMPLATE(BM_BufferTake, 1024, 8);
+BENCHMARK_TEMPLATE(BM_BufferTake, 1024, 64);
+BENCHMARK_TEMPLATE(BM_SpanTake, 64, 8);
+BENCHMARK_TEMPLATE(BM_SpanTake, 1024, 8);
+BENCHMARK_TEMPLATE(BM_SpanTake, 1024, 64);
+BENCHMARK_TEMPLATE(BM_BufferViewTake, 64, 8);
+BENCHMARK_TEMPLATE(BM_BufferViewTake, 1024, 8);
+BENCHMARK_TEMPLATE(BM_BufferViewTake, 1024, 64);
+
+BENCHMARK_TEMPLATE(BM_BufferReassemble, 1);
+BENCHMARK_TEMPLATE(BM_BufferReassemble, 8);
+BENCHMARK_TEMPLATE(BM_BufferReassemble, 64);
+BENCHMARK_TEMPLATE(BM_FrameParserReassemble, 1);
+BENCHMARK_TEMPLATE(BM_FrameParserReassemble, 8);
+BENCHMARK_TEMPLATE(BM_FrameParserReassemble, 64);
+
+BENCHMARK_TEMPLATE(BM_BufferToBytes, uint16_t, 1024, Meta::Endian::Native);
+BENCHMARK_TEMPLATE(BM_BufferToBytes, uint16_t, 1024, Meta::Endian::Big);
+BENCHMARK_TEMPLATE(BM_BufferToBytes, uint32_t, 64, Meta::Endian::Native);
+BENCHMARK_TEMPLATE(BM_BufferToBytes, uint32_t, 1024, Meta::Endian::Native);
+BENCHMARK_TEMPLATE(BM_BufferToBytes, uint32_t, 1024, Meta::Endian::Big);
+BENCHMARK_TEMPLATE(BM_VectorToBytes, uint16_t, 1024, Meta::Endian::Native);
+BENCHMARK_TEMPLATE(BM_VectorToBytes, uint16_t, 1024, Meta::Endian::Big);
+BENCHMARK_TEMPLATE(BM_VectorToBytes, uint32_t, 64, Meta::Endian::Native);
+BENCHMARK_TEMPLATE(BM_VectorToBytes, uint32_t, 1024, Meta::Endian::Native);
+BENCHMARK_TEMPLATE(BM_VectorToBytes, uint32_t, 1024, Meta::Endian::Big);
+
+BENCHMARK(BM_SerializerDecode);
+BENCHMARK(BM_HandDecode);
+
+BENCHMARK(BM_BufferFind);
+BENCHMARK(BM_LoopFind);
+BENCHMARK(BM_BufferFindAny);
+
+BENCHMARK(BM_AoSPower);
+BENCHMARK(BM_SoAPower);
+
+BENCHMARK_TEMPLATE(BM_RingBufferPushPop, uint8_t, 64);
+BENCHMARK_TEMPLATE(BM_RingBufferPushPop, uint32_t, 1024);
+BENCHMARK_TEMPLATE(BM_RingBufferPushPop, Sample, 1024);
@@ -0,0 +1,59 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include "../Utils/ArrayUtils.hpp"
+#include "../Utils/Crc.hpp"
+
+namespace {
+
+constexpr auto PAYLOAD = Meta::randomArray<uint8_t, 4096>();
+
+// The bit-at-a-time loop Crc replaces
+uint32_t bitwiseCrc32(const uint8_t* bytes, size_t len) {
+    uint32_t crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= bytes[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320 : crc >> 1;
+        }
+    }
+    return ~crc;
+}
+
+void BM_CrcBitwise(benchmark::State& state) {
+    const size_t len = (size_t)state.range(0);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(bitwiseCrc32(PAYLOAD.data(), len));
+    }
+    state.SetBytesProcessed(state.iterations() * len);
+}
+
+template<typename C>
+void BM_Crc(benchmark::State& state) {
+    const size_t len = (size_t)state.range(0);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(C::compute(PAYLOAD.data(), len));
+    }
+    state.SetBytesProcessed(state.iterations() * len);
+}
+
+// A frame checked as it arrives in 64 byte pieces
+template<typename C>
+void BM_CrcStreaming(benchmark::State& state) {
+    const size_t len = (size_t)state.range(0);
+    for (auto _ : state) {
+        C crc;
+        for (size_t i = 0; i < len; i += 64) {
+            crc.update(PAYLOAD.data() + i, len - i < 64 ? len - i : 64);
+        }
+        benchmark::DoNotOptimize(crc.value());
+    }
+    state.SetBytesProcessed(state.iterations() * len);
+}
+
+}
+
+BENCHMARK(BM_CrcBitwise)->Arg(64)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_Crc, Meta::Crc16Ccitt)->Arg(64)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_Crc, Meta::Crc32)->Arg(64)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_Crc, Meta::Crc32C)->Arg(64)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_CrcStreaming, Meta::Crc32)->Arg(4096);
@@ -0,0 +1,106 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include "../Errors/ErrorUnion.hpp"
+#include "../Errors/Errors.hpp"
+
+namespace {
+
+const Meta::ErrorDef BENCH_ERROR = REGISTER_ERROR("BENCH_ERROR");
+
+// Every callee is kept out of line so each benchmark pays for a real call and return
+
+__attribute__((noinline)) bool checkBool(uint32_t x) {
+    benchmark::DoNotOptimize(x);
+    return x != 0;
+}
+
+__attribute__((noinline)) Meta::ErrorUnion<void> checkUnion(uint32_t x) {
+    benchmark::DoNotOptimize(x);
+    if (x == 0) {
+        return Meta::ErrorUnion<void>(MAKE_ERROR(BENCH_ERROR, "Zero"));
+    }
+    return Meta::ErrorUnion<void>();
+}
+
+__attribute__((noinline)) bool readOut(uint32_t x, uint32_t* out) {
+    benchmark::DoNotOptimize(x);
+    *out = x + 1;
+    return x != 0;
+}
+
+__attribute__((noinline)) Meta::ErrorUnion<uint32_t> readUnion(uint32_t x) {
+    benchmark::DoNotOptimize(x);
+    if (x == 0) {
+        return Meta::ErrorUnion<uint32_t>(MAKE_ERROR(BENCH_ERROR, "Zero"));
+    }
+    return Meta::ErrorUnion<uint32_t>(x + 1);
+}
+
+__attribute__((noinline)) Meta::ErrorUnion<uint64_t> readUnion64(uint64_t x) {
+    benchmark::DoNotOptimize(x);
+    if (x == 0) {
+        return Meta::ErrorUnion<uint64_t>(MAKE_ERROR(BENCH_ERROR, "Zero"));
+    }
+    return Meta::ErrorUnion<uint64_t>(x + 1);
+}
+
+void BM_ReturnBool(benchmark::State& state) {
+    uint32_t x = (uint32_t)state.range(0);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(checkBool(x));
+    }
+}
+
+void BM_ReturnErrorUnionVoid(benchmark::State& state) {
+    uint32_t x = (uint32_t)state.range(0);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(checkUnion(x).hasError());
+    }
+}
+
+void BM_ReturnOutParam(benchmark::State& state) {
+    uint32_t x = (uint32_t)state.range(0);
+    for (auto _ : state) {
+        uint32_t out;
+        benchmark::DoNotOptimize(readOut(x, &out));
+        benchmark::DoNotOptimize(out);
+    }
+}
+
+void BM_ReturnErrorUnionValue(benchmark::State& state) {
+    uint32_t x = (uint32_t)state.range(0);
+    for (auto _ : state) {
+        auto r = readUnion(x);
+        benchmark::DoNotOptimize(r.hasError());
+        benchmark::DoNotOptimize(r.value_or(0));
+    }
+}
+
+void BM_ReturnErrorUnionValue64(benchmark::State& state) {
+    uint64_t x = (uint64_t)state.range(0);
+    for (auto _ : state) {
+        auto r = readUnion64(x);
+        benchmark::DoNotOptimize(r.hasError());
+        benchmark::DoNotOptimize(r.value_or(0));
+    }
+}
+
+void BM_ErrorUnionChain(benchmark::State& state) {
+    uint32_t x = (uint32_t)state.range(0);
+    for (auto _ : state) {
+        auto r = readUnion(x)
+            .and_then([](uint32_t v) { return readUnion(v); })
+            .transform([](uint32_t v) { return v * 2; });
+        benchmark::DoNotOptimize(r.value_or(0));
+    }
+}
+
+}
+
+// Arguments: 1 takes the success path, 0 the error path
+BENCHMARK(BM_ReturnBool)->Arg(1)->Arg(0);
+BENCHMARK(BM_ReturnErrorUnionVoid)->Arg(1)->Arg(0);
+BENCHMARK(BM_ReturnOutParam)->Arg(1)->Arg(0);
+BENCHMARK(BM_ReturnErrorUnionValue)->Arg(1)->Arg(0);
+BENCHMARK(BM_ReturnErrorUnionValue64)->Arg(1)->Arg(0);
+BENCHMARK(BM_ErrorUnionChain)->Arg(1)->Arg(0);
@@ -0,0 +1,164 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <cstdio>
+#include "../Logging/AsyncLogger.hpp"
+#include "../Logging/ILogger.hpp"
+#include "../Logging/TokenLogger.hpp"
+#include "../Structures/Buffer.hpp"
+#include "../Utils/Format.hpp"
+#include "NullLogger.hpp"
+
+namespace {
+
+// Enabled at compile time, rejected by the logger's level at runtime
+void BM_LogDebugRuntimeFiltered(benchmark::State& state) {
+    NullLogger logger(Meta::LOG_LEVEL_INFO);
+    SET_LOGGER(logger);
+    uint32_t x = 42;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(x);
+        LOG_DEBUG("Value %u", x);
+    }
+    SET_LOGGER(nullptr);
+}
+
+// Enabled and formatted, but written nowhere
+void BM_LogDebugFormatted(benchmark::State& state) {
+    NullLogger logger(Meta::LOG_LEVEL_DEBUG);
+    SET_LOGGER(logger);
+    uint32_t x = 42;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(x);
+        LOG_DEBUG("Value %u", x);
+    }
+    state.SetBytesProcessed(logger.written);
+    SET_LOGGER(nullptr);
+}
+
+void BM_LogDebugDeferred(benchmark::State& state) {
+    NullLogger sink(Meta::LOG_LEVEL_DEBUG);
+    Meta::AsyncLogger<1024> async(sink);
+    SET_LOGGER(async);
+    uint32_t x = 42;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(x);
+        LOG_DEBUG("Value %u", x);
+        if (async.pending() >= 512) {
+            state.PauseTiming();
+            async.drain(1024);
+            state.ResumeTiming();
+        }
+    }
+    SET_LOGGER(nullptr);
+}
+
+// Several threads logging into one queue at once
+void BM_LogDebugDeferredMpsc(benchmark::State& state) {
+    static NullLogger sink(Meta::LOG_LEVEL_DEBUG);
+    static Meta::MpscAsyncLogger<1024> async(sink);
+    SET_LOGGER(async);
+    uint32_t x = 42;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(x);
+        LOG_DEBUG("Value %u", x);
+        if (state.thread_index() == 0 && async.pending() >= 512) {
+            async.drain(1024);
+        }
+    }
+    if (state.thread_index() == 0) {
+        async.drain(1024);
+        SET_LOGGER(nullptr);
+    }
+}
+
+void BM_LogTokenDebug(benchmark::State& state) {
+    NullLogger logger(Meta::LOG_LEVEL_DEBUG);
+    SET_LOGGER(logger);
+    uint32_t x = 42;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(x);
+        LOG_TOKEN_DEBUG("Value %u", x);
+    }
+    state.SetBytesProcessed(logger.written);
+    SET_LOGGER(nullptr);
+}
+
+void BM_HexDump(benchmark::State& state) {
+    NullLogger logger(Meta::LOG_LEVEL_DEBUG);
+    SET_LOGGER(logger);
+    Meta::Buffer<uint8_t, 256> buf(Meta::repeat<uint8_t, 256>(0xA5));
+    for (auto _ : state) {
+        buf.hexDump("Dump");
+    }
+    state.SetBytesProcessed(state.iterations() * buf.size());
+    SET_LOGGER(nullptr);
+}
+
+// The message part of a log line on its own, against the snprintf it replaced
+void BM_FormatWrite(benchmark::State& state) {
+    char out[128];
+    uint32_t x = 42;
+    size_t len = 1234567;
+    const char* name = "uart0";
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(x);
+        benchmark::DoNotOptimize(out);
+        benchmark::DoNotOptimize(Meta::Format::write(out, sizeof(out), "%s: value %u, length %zu, flags 0x%08x", name, x, len, x));
+    }
+}
+
+void BM_Snprintf(benchmark::State& state) {
+    char out[128];
+    uint32_t x = 42;
+    size_t len = 1234567;
+    const char* name = "uart0";
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(x);
+        benchmark::DoNotOptimize(out);
+        benchmark::DoNotOptimize(snprintf(out, sizeof(out), "%s: value %u, length %zu, flags 0x%08x", name, x, len, x));
+    }
+}
+
+}
+
+// Everything below is built as if the project were configured with META_LOG_MIN_LEVEL=LOG_LEVEL_INFO. The
+// headers above were already expanded with the default, so only the call sites here see the new limit.
+#undef META_LOG_MIN_LEVEL
+#define META_LOG_MIN_LEVEL Meta::LOG_LEVEL_INFO
+
+namespace {
+
+void BM_LogDebugCompiledOut(benchmark::State& state) {
+    NullLogger logger(Meta::LOG_LEVEL_DEBUG);
+    SET_LOGGER(logger);
+    uint32_t x = 42;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(x);
+        LOG_DEBUG("Value %u", x);
+    }
+    SET_LOGGER(nullptr);
+}
+
+void BM_LogTokenDebugCompiledOut(benchmark::State& state) {
+    NullLogger logger(Meta::LOG_LEVEL_DEBUG);
+    SET_LOGGER(logger);
+    uint32_t x = 42;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(x);
+        LOG_TOKEN_DEBUG("Value %u", x);
+    }
+    SET_LOGGER(nullptr);
+}
+
+}
+
+BENCHMARK(BM_LogDebugCompiledOut);
+BENCHMARK(BM_LogDebugRuntimeFiltered);
+BENCHMARK(BM_LogDebugFormatted);
+BENCHMARK(BM_LogDebugDeferred);
+BENCHMARK(BM_LogDebugDeferredMpsc)->Threads(1)->Threads(4);
+BENCHMARK(BM_LogTokenDebugCompiledOut);
+BENCHMARK(BM_LogTokenDebug);
+BENCHMARK(BM_HexDump);
+BENCHMARK(BM_FormatWrite);
+BENCHMARK(BM_Snprintf);
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+#include "../Logging/ILogger.hpp"
+
+/**
+ * @brief A logger that formats every line as usual but throws the output away, so benchmarks time the logging
+ *         path rather than the terminal.
+ */
+class NullLogger : public Meta::ILogger {
+private:
+    const char* getTimestamp() override {
+        return "00:00:00";
+    }
+
+public:
+    size_t written = 0; // Bytes that would have been written
+
+    NullLogger(Meta::LogLevel level = Meta::LOG_LEVEL_DEBUG) : ILogger(level) {}
+
+    void rawLog(const char* msg) override {
+        benchmark::DoNotOptimize(msg);
+        written += strlen(msg);
+    }
+
+    void rawWrite(const char* data, size_t len) override {
+        benchmark::DoNotOptimize(data);
+        written += len;
+    }
+};
+
+/**
+ * @brief NullLogger bound at compile time, for builds with META_LOGGER_TYPE=NullStaticLogger.
+ */
+class NullStaticLogger : public Meta::BasicLogger<NullStaticLogger> {
+public:
+    size_t written = 0; // Bytes that would have been written
+
+    constexpr NullStaticLogger(Meta::LogLevel level = Meta::LOG_LEVEL_DEBUG) : BasicLogger(level) {}
+
+    size_t writeTimestamp(char* out, size_t capacity) {
+        const size_t n = capacity < 8 ? capacity : 8;
+        memcpy(out, "00:00:00", n);
+        return n;
+    }
+
+    void rawWrite(const char* data, size_t len) {
+        benchmark::DoNotOptimize(data);
+        written += len;
+    }
+};
@@ -0,0 +1,35 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include "../Logging/ILogger.hpp"
+#include "NullLogger.hpp"
+
+// Built with META_LOGGER_TYPE=NullStaticLogger, so the LOG macros here call NullStaticLogger directly. Compare with
+// BM_LogDebugRuntimeFiltered and BM_LogDebugFormatted, which go through LogBroker's ILogger.
+
+namespace {
+
+void BM_StaticLogDebugRuntimeFiltered(benchmark::State& state) {
+    SET_LOG_LEVEL(Meta::LOG_LEVEL_INFO);
+    uint32_t x = 42;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(x);
+        LOG_DEBUG("Value %u", x);
+    }
+    SET_LOG_LEVEL(Meta::LOG_LEVEL_DEBUG);
+}
+
+void BM_StaticLogDebugFormatted(benchmark::State& state) {
+    NullStaticLogger& logger = META_LOGGER();
+    const size_t before = logger.written;
+    uint32_t x = 42;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(x);
+        LOG_DEBUG("Value %u", x);
+    }
+    state.SetBytesProcessed(logger.written - before);
+}
+
+}
+
+BENCHMARK(BM_StaticLogDebugRuntimeFiltered);
+BENCHMARK(BM_StaticLogDebugFormatted);
@@ -0,0 +1,15 @@
+// A Buffer filled, drained and serialized. Compare with VectorAppend.o.
+#include <cstdint>
+#include "../../Structures/Buffer.hpp"
+
+static Meta::Buffer<uint16_t, 64> buf;
+
+bool sizeBufferAppend(const uint16_t* samples, size_t len, uint8_t* out) {
+    if (buf.append(samples, len).hasError()) {
+        return false;
+    }
+    auto bytes = buf.toBytes<Meta::Endian::Big>();
+    memcpy(out, bytes.cArr(), bytes.size());
+    buf.clear();
+    return true;
+}
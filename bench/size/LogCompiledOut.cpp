@@ -0,0 +1,10 @@
+// The same sites as LogRuntimeFiltered.cpp, built with META_LOG_MIN_LEVEL=LOG_LEVEL_WARNING.
+#include <cstdint>
+#include "../../Logging/ILogger.hpp"
+
+void sizeLogSites(uint32_t a, uint32_t b) {
+    LOG_DEBUG("Entering");
+    LOG_DEBUG("a = %u", a);
+    LOG_DEBUG("a = %u, b = %u", a, b);
+    LOG_WARNING("Leaving");
+}
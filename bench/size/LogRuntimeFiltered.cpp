@@ -0,0 +1,10 @@
+// Debug logging left in the build and filtered by the logger's level at runtime. Compare with LogCompiledOut.o.
+#include <cstdint>
+#include "../../Logging/ILogger.hpp"
+
+void sizeLogSites(uint32_t a, uint32_t b) {
+    LOG_DEBUG("Entering");
+    LOG_DEBUG("a = %u", a);
+    LOG_DEBUG("a = %u, b = %u", a, b);
+    LOG_WARNING("Leaving");
+}
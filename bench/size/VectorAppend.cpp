@@ -0,0 +1,20 @@
+// The std::vector equivalent of BufferAppend.cpp.
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "../../Utils/Endian.hpp"
+
+static std::vector<uint16_t> vec;
+
+bool sizeBufferAppend(const uint16_t* samples, size_t len, uint8_t* out) {
+    if (vec.size() + len > 64) {
+        return false;
+    }
+    vec.insert(vec.end(), samples, samples + len);
+    for (size_t i = 0; i < vec.size(); i++) {
+        const uint16_t t = Meta::toEndian<Meta::Endian::Big>(vec[i]);
+        memcpy(out + 2 * i, &t, 2);
+    }
+    vec.clear();
+    return true;
+}
@@ -0,0 +1,52 @@
+#include <cstdio>
+#include <string>
+#include <gtest/gtest.h>
+#include "Utils/Format.hpp"
+
+namespace {
+    template<typename... Args>
+    std::string format(const char* fmt, const Args&... args) {
+        char out[128];
+        const size_t len = Meta::Format::write(out, sizeof(out), fmt, args...);
+        return std::string(out, len < sizeof(out) ? len : sizeof(out));
+    }
+
+    template<typename... Args>
+    std::string printf(const char* fmt, const Args&... args) {
+        char out[128];
+        snprintf(out, sizeof(out), fmt, args...);
+        return out;
+    }
+}
+
+TEST(Format, FloatRoundsOnTheExactValue) {
+    // Neither is a half once stored as a double, which the rounded product hides
+    EXPECT_EQ(format("%.1f", 0.05), "0.1");
+    EXPECT_EQ(format("%.1f", 0.35), "0.3");
+    EXPECT_EQ(format("%.3f", 0.0005), "0.001");
+    EXPECT_EQ(format("%.2f", 1.005), "1.00");
+}
+
+TEST(Format, FloatRoundsExactHalvesToEven) {
+    EXPECT_EQ(format("%.0f", 0.5), "0");
+    EXPECT_EQ(format("%.0f", 1.5), "2");
+    EXPECT_EQ(format("%.0f", 2.5), "2");
+    EXPECT_EQ(format("%.1f", 0.25), "0.2");
+    EXPECT_EQ(format("%.1f", 0.75), "0.8");
+    EXPECT_EQ(format("%.2f", 9.995), "9.99");
+}
+
+TEST(Format, FloatMatchesPrintf) {
+    const char* const formats[] = {"%.0f", "%.1f", "%.2f", "%.3f", "%f", "%+08.3f", "%-10.4f|"};
+    uint64_t state = 0x9E3779B97F4A7C15ull;
+    for (int i = 0; i < 20000; i++) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        // Binary fractions hit exact halves, decimal ones land just either side of them
+        const double binary = (double)(int64_t)(state >> 40) / (double)(1u << ((state >> 8) & 15)) - 4096.0;
+        const double decimal = (double)(int64_t)(state >> 44) / 10000.0 - 512.0;
+        for (const char* fmt : formats) {
+            ASSERT_EQ(format(fmt, binary), printf(fmt, binary)) << fmt << " of " << binary;
+            ASSERT_EQ(format(fmt, decimal), printf(fmt, decimal)) << fmt << " of " << decimal;
+        }
+    }
+}